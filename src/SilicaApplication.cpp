@@ -1,6 +1,10 @@
 #include "include/silica/Application.h"
 #include <silica/EventGenerator.h>
 #include <silica/LoggingSystem.h>
+#include <silica/Trace.h>
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+    #include <silica/ThreadPool.h>
+#endif
 
 
 static_assert(SILICA_EVENT_GENERATORS_HELD_BY_APPLICATION >= 0, "SILICA_EVENT_GENERATORS_HELD_BY_APPLICATION must be a non negative integer. Use 0 for infinite and growing capacity.");
@@ -10,7 +14,7 @@ namespace Silica {
 Application* Application::theApplicationInstance = nullptr;
 
 Application::Application()
-    : exit(std::bind(&Application::exitImplementation, this, std::placeholders::_1))
+    : exit(Slot<int>::fromMethod<&Application::exitImplementation>(this))
 {
     printf("Application()::theApplicationInstance  = %p\n", Application::theApplicationInstance ); fflush(stdout);
     if ( Application::theApplicationInstance )
@@ -26,27 +30,382 @@ Application::Application()
 Application::~Application()
 {
     printf("~Application()::theApplicationInstance  = %p\n", Application::theApplicationInstance ); fflush(stdout);
+    while(d.firstRegisteredEventGenerator)
+    {
+        EventGenerator *eventGenerator = d.firstRegisteredEventGenerator;
+        cancelWakeAt(eventGenerator);
+        unregisterEventGenerator(eventGenerator);
+        eventGenerator->waitForWakesInProgress();
+        forgetReady(eventGenerator);
+        eventGenerator->d.isReady.store(false);
+    }
     Application::theApplicationInstance = nullptr;
     printf("~Application()::theApplicationInstance  = %p\n", Application::theApplicationInstance ); fflush(stdout);
 }
 
 int Application::exec()
 {
-    while( ! d.exitRequested )
+    while( ! d.exitRequested.load() )
     {
-        for(auto eventGenerator : d.eventGenerators)
+        const uint64_t passStart = instrumentationTimestamp();
+        if(d.firstTimedEventGenerator)
+        {
+            wakeDueEventGenerators();
+        }
+
+        bool hasRunTasks = false;
+        if(d.queuedTaskCount.load(std::memory_order_acquire) > 0)
         {
-            eventGenerator->visit();
+            runQueuedTasks();
+            hasRunTasks = true;
+        }
+
+        EventGenerator *ready = d.readyHead.exchange(nullptr, std::memory_order_acq_rel);
+        if( ! ready )
+        {
+            if(loopInstrumentationEnabled && hasRunTasks)
+            {
+                d.loopCounters.record(instrumentationTimestamp() - passStart);
+            }
+            if(d.queuedTaskCount.load(std::memory_order_acquire) > 0)
+            {
+                continue;
+            }
+            waitForReadyEventGenerators();
+            continue;
+        }
+
+        TraceScope trace("Application::pass", this);
+
+        // The ready list is LIFO, so reverse it to visit in the order of waking.
+        EventGenerator *pass = nullptr;
+        while(ready)
+        {
+            EventGenerator *next = ready->d.nextReady;
+            ready->d.nextReady = pass;
+            pass = ready;
+            ready = next;
+        }
+
+        d.passHead = pass;
+        while(d.passHead)
+        {
+            EventGenerator *eventGenerator = d.passHead;
+            d.passHead = eventGenerator->d.nextReady;
+            eventGenerator->d.nextReady = nullptr;
+            eventGenerator->d.isReady.store(false, std::memory_order_release);
+            visit(eventGenerator);
+        }
+        if(loopInstrumentationEnabled)
+        {
+            d.loopCounters.record(instrumentationTimestamp() - passStart);
         }
     }
+    // Cleared on the way out rather than on the way in, so an exit requested before exec() is not lost, while exec() may be called again.
+    d.exitRequested.store(false);
     return d.providedExitCode;
 }
 
 
+void Application::visit(EventGenerator *eventGenerator)
+{
+    TraceScope trace("EventGenerator::visit", eventGenerator);
+    if constexpr ( ! loopInstrumentationEnabled )
+    {
+        eventGenerator->visit();
+    }
+    else
+    {
+        d.visitedEventGenerator = eventGenerator;
+        const uint64_t visitStart = instrumentationTimestamp();
+        eventGenerator->visit();
+        if(d.visitedEventGenerator)
+        {
+            eventGenerator->d.visitCounters.record(instrumentationTimestamp() - visitStart);
+        }
+        d.visitedEventGenerator = nullptr;
+    }
+}
+
+uint64_t Application::instrumentationTimestamp() const
+{
+    if constexpr (loopInstrumentationEnabled)
+    {
+        return microsecondsSinceStart();
+    }
+    else
+    {
+        return 0;
+    }
+}
+
+LoopStatistics Application::loopStatistics() const
+{
+    LoopStatistics result;
+    d.loopCounters.snapshot(result);
+    return result;
+}
+
+void Application::resetLoopStatistics()
+{
+    d.loopCounters.reset();
+}
+
 void Application::exitImplementation(int exitCode)
 {
-    d.exitRequested  = true;
     d.providedExitCode = exitCode;
+    d.exitRequested.store(true);
+    notifyLoop();
+}
+
+bool Application::registerEventGenerator(EventGenerator *eventGenerator)
+{
+#if SILICA_EVENT_GENERATORS_HELD_BY_APPLICATION > 0
+    if(d.registeredEventGeneratorCount >= SILICA_EVENT_GENERATORS_HELD_BY_APPLICATION)
+    {
+        WARN("EventGenerator not registered: SILICA_EVENT_GENERATORS_HELD_BY_APPLICATION (%d) reached", int(SILICA_EVENT_GENERATORS_HELD_BY_APPLICATION));
+        return false;
+    }
+#endif
+
+    eventGenerator->d.previousRegistered = nullptr;
+    eventGenerator->d.nextRegistered = d.firstRegisteredEventGenerator;
+    if(d.firstRegisteredEventGenerator)
+    {
+        d.firstRegisteredEventGenerator->d.previousRegistered = eventGenerator;
+    }
+    d.firstRegisteredEventGenerator = eventGenerator;
+    eventGenerator->d.isRegistered.store(true, std::memory_order_seq_cst);
+    d.registeredEventGeneratorCount++;
+    return true;
+}
+
+void Application::unregisterEventGenerator(EventGenerator *eventGenerator)
+{
+    if( ! eventGenerator->d.isRegistered.load(std::memory_order_relaxed) )
+    {
+        return;
+    }
+
+    if(eventGenerator->d.previousRegistered)
+    {
+        eventGenerator->d.previousRegistered->d.nextRegistered = eventGenerator->d.nextRegistered;
+    }
+    else
+    {
+        d.firstRegisteredEventGenerator = eventGenerator->d.nextRegistered;
+    }
+    if(eventGenerator->d.nextRegistered)
+    {
+        eventGenerator->d.nextRegistered->d.previousRegistered = eventGenerator->d.previousRegistered;
+    }
+
+    if(d.visitedEventGenerator == eventGenerator)
+    {
+        d.visitedEventGenerator = nullptr;
+    }
+    eventGenerator->d.previousRegistered = nullptr;
+    eventGenerator->d.nextRegistered = nullptr;
+    eventGenerator->d.isRegistered.store(false, std::memory_order_seq_cst);
+    d.registeredEventGeneratorCount--;
+}
+
+void Application::markReady(EventGenerator *eventGenerator)
+{
+    EventGenerator *head = d.readyHead.load(std::memory_order_relaxed);
+    do
+    {
+        eventGenerator->d.nextReady = head;
+    }
+    while( ! d.readyHead.compareExchangeWeak(head, eventGenerator, std::memory_order_seq_cst, std::memory_order_relaxed) );
+    notifyLoop();
+}
+
+void Application::forgetReady(EventGenerator *eventGenerator)
+{
+    // Must be called from the loop thread, which is the only one unlinking from the lists.
+    if( ! eventGenerator->d.isReady.load(std::memory_order_acquire) )
+    {
+        return;
+    }
+
+    for(EventGenerator **link = &d.passHead; *link; link = &(*link)->d.nextReady)
+    {
+        if(*link == eventGenerator)
+        {
+            *link = eventGenerator->d.nextReady;
+            return;
+        }
+    }
+
+    EventGenerator *expected = eventGenerator;
+    if(d.readyHead.compareExchange(expected, eventGenerator->d.nextReady, std::memory_order_acq_rel))
+    {
+        return;
+    }
+    // Other threads only ever push at the head, so nodes behind it can be unlinked safely.
+    for(EventGenerator *candidate = d.readyHead.load(std::memory_order_acquire); candidate; candidate = candidate->d.nextReady)
+    {
+        if(candidate->d.nextReady == eventGenerator)
+        {
+            candidate->d.nextReady = eventGenerator->d.nextReady;
+            return;
+        }
+    }
+}
+
+void Application::scheduleWakeAt(EventGenerator *eventGenerator, MicroSeconds time)
+{
+    cancelWakeAt(eventGenerator);
+
+    EventGenerator *previous = nullptr;
+    EventGenerator *next = d.firstTimedEventGenerator;
+    while(next && (uint64_t(next->d.wakeUpTime) <= uint64_t(time)))
+    {
+        previous = next;
+        next = next->d.nextTimed;
+    }
+
+    eventGenerator->d.wakeUpTime = time;
+    eventGenerator->d.previousTimed = previous;
+    eventGenerator->d.nextTimed = next;
+    if(previous)
+    {
+        previous->d.nextTimed = eventGenerator;
+    }
+    else
+    {
+        d.firstTimedEventGenerator = eventGenerator;
+    }
+    if(next)
+    {
+        next->d.previousTimed = eventGenerator;
+    }
+    eventGenerator->d.isTimed = true;
+}
+
+void Application::cancelWakeAt(EventGenerator *eventGenerator)
+{
+    if( ! eventGenerator->d.isTimed )
+    {
+        return;
+    }
+
+    if(eventGenerator->d.previousTimed)
+    {
+        eventGenerator->d.previousTimed->d.nextTimed = eventGenerator->d.nextTimed;
+    }
+    else
+    {
+        d.firstTimedEventGenerator = eventGenerator->d.nextTimed;
+    }
+    if(eventGenerator->d.nextTimed)
+    {
+        eventGenerator->d.nextTimed->d.previousTimed = eventGenerator->d.previousTimed;
+    }
+
+    eventGenerator->d.previousTimed = nullptr;
+    eventGenerator->d.nextTimed = nullptr;
+    eventGenerator->d.isTimed = false;
+}
+
+void Application::wakeDueEventGenerators()
+{
+    const uint64_t now = microsecondsSinceStart();
+    while(d.firstTimedEventGenerator && (uint64_t(d.firstTimedEventGenerator->d.wakeUpTime) <= now))
+    {
+        EventGenerator *eventGenerator = d.firstTimedEventGenerator;
+        cancelWakeAt(eventGenerator);
+        eventGenerator->wake();
+    }
+}
+
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+bool Application::post(Task task)
+{
+    if( ! d.threadPool )
+    {
+        WARN("Application::post() without a ThreadPool");
+        return false;
+    }
+    return d.threadPool->post(std::move(task));
+}
+#endif
+
+void Application::invokeOnLoop(Task task)
+{
+    {
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+        MutexLocker locker(d.queuedTasksMutex);
+#endif
+        d.queuedTasks.pushBack(std::move(task));
+    }
+    d.queuedTaskCount.fetchAdd(1, std::memory_order_seq_cst);
+    notifyLoop();
+}
+
+void Application::runQueuedTasks()
+{
+    TraceScope trace("Application::runQueuedTasks", this);
+    // Only run what is queued now, so tasks queuing tasks cannot starve the EventGenerators.
+    size_t count = d.queuedTaskCount.load(std::memory_order_acquire);
+    Task task;
+    while(count > 0)
+    {
+        {
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+            MutexLocker locker(d.queuedTasksMutex);
+#endif
+            if( ! d.queuedTasks.popFront(task) )
+            {
+                break;
+            }
+        }
+        d.queuedTaskCount.fetchSub(1, std::memory_order_relaxed);
+        count--;
+        task();
+        task.reset();
+    }
+}
+
+void Application::notifyLoop()
+{
+    if(d.loopSleeping.load(std::memory_order_seq_cst) && d.loopSleeping.exchange(false, std::memory_order_seq_cst))
+    {
+        d.loopWakeups.release(1);
+    }
+}
+
+void Application::waitForReadyEventGenerators()
+{
+    d.loopSleeping.store(true, std::memory_order_seq_cst);
+    if( (d.readyHead.load(std::memory_order_seq_cst) == nullptr)
+        && (d.queuedTaskCount.load(std::memory_order_seq_cst) == 0)
+        && ! d.exitRequested.load() )
+    {
+        if( ! d.firstTimedEventGenerator )
+        {
+            d.loopWakeups.acquire();
+            return;
+        }
+
+        const uint64_t now = microsecondsSinceStart();
+        const uint64_t due = d.firstTimedEventGenerator->d.wakeUpTime;
+        if( (due > now) && d.loopWakeups.tryAcquireFor(MicroSeconds(due - now)) )
+        {
+            return;
+        }
+        if( ! d.loopSleeping.exchange(false, std::memory_order_seq_cst) )
+        {
+            // Woken right as the wait timed out, so a token was released. Consume it.
+            d.loopWakeups.acquire();
+        }
+    }
+    else if( ! d.loopSleeping.exchange(false, std::memory_order_seq_cst) )
+    {
+        // Someone woke us in the meantime and released a token. Consume it.
+        d.loopWakeups.acquire();
+    }
 }
 
 Application * Application::instance()
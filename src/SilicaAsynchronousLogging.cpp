@@ -0,0 +1,423 @@
+#include <silica/LoggingSystem.h>
+#include <silica/Semaphore.h>
+#include <inttypes.h>
+#include <stdlib.h>
+#include <new>
+#include <thread>
+
+static_assert( (SILICA_LOGGING_QUEUE_CAPACITY & (SILICA_LOGGING_QUEUE_CAPACITY - 1)) == 0, "SILICA_LOGGING_QUEUE_CAPACITY must be a power of two");
+
+namespace Silica
+{
+
+/// \cond DEVELOPER_DOC
+
+namespace
+{
+
+/*
+ * The staging buffer of one logging thread: a bounded single producer,
+ * single consumer ring. Only the owning thread pushes, only the writer thread
+ * pops, so neither ever waits for or contends with another logging thread.
+ * Buffers are never freed. When its thread exits, a buffer is released, and
+ * taken over by the next thread starting to log once the writer drained it.
+ */
+class ThreadLogBuffer
+{
+public:
+    bool tryPush(const LogEntry &entry)
+    {
+        const size_t position = pushPosition.load(std::memory_order_relaxed);
+        if(position - popPosition.load(std::memory_order_acquire) == SILICA_LOGGING_QUEUE_CAPACITY)
+        {
+            return false; // Full
+        }
+        new (slots[position & mask].storage) LogEntry(entry);
+        pushPosition.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    /* Returns the oldest entry, which stays valid until pop(), or nullptr if the buffer is empty. Only called by the writer thread. */
+    const LogEntry *front() const
+    {
+        const size_t position = popPosition.load(std::memory_order_relaxed);
+        if(pushPosition.load(std::memory_order_acquire) == position)
+        {
+            return nullptr;
+        }
+        return std::launder(reinterpret_cast<const LogEntry*>(slots[position & mask].storage));
+    }
+
+    void pop()
+    {
+        const size_t position = popPosition.load(std::memory_order_relaxed);
+        std::launder(reinterpret_cast<LogEntry*>(slots[position & mask].storage))->~LogEntry();
+        popPosition.store(position + 1, std::memory_order_release);
+    }
+
+    /* The number of entries ever pushed. */
+    size_t pushed() const { return pushPosition.load(std::memory_order_acquire); }
+
+    /* The number of entries ever handed to the sinks. */
+    size_t popped() const { return popPosition.load(std::memory_order_acquire); }
+
+    std::atomic<bool> isOwned{true};
+    ThreadLogBuffer *next = nullptr;
+
+private:
+    static constexpr size_t mask = SILICA_LOGGING_QUEUE_CAPACITY - 1;
+
+    struct Slot
+    {
+        alignas(LogEntry) unsigned char storage[sizeof(LogEntry)];
+    };
+
+    Slot slots[SILICA_LOGGING_QUEUE_CAPACITY];
+    alignas(64) std::atomic<size_t> pushPosition{0};
+    alignas(64) std::atomic<size_t> popPosition{0};
+};
+
+/* Releases the staging buffer of a thread when the thread exits. */
+struct ThreadLogBufferOwnership
+{
+    ThreadLogBuffer *buffer = nullptr;
+
+    ~ThreadLogBufferOwnership()
+    {
+        if(buffer)
+        {
+            buffer->isOwned.store(false, std::memory_order_release);
+        }
+    }
+};
+
+thread_local ThreadLogBufferOwnership theThreadLogBuffer;
+
+thread_local bool isWriterThread = false;
+
+}
+
+class AsynchronousLogWriter
+{
+public:
+    std::atomic<ThreadLogBuffer*> buffers{nullptr};
+    LoggingSystem::QueuePolicy policy = LoggingSystem::QueuePolicy::Drop;
+
+    std::atomic<uint64_t> dropped{0};
+    uint64_t droppedReported = 0;
+
+    std::atomic<bool> isSleeping{false};
+    std::atomic<bool> isStopping{false};
+    std::atomic<bool> isFlushRequested{false};
+    Semaphore wakeUp;
+    std::thread thread;
+
+    void wake()
+    {
+        // Pairs with the fence of run(): either the writer sees what was pushed or set before, or this sees it sleeping.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if(isSleeping.load(std::memory_order_relaxed) && isSleeping.exchange(false))
+        {
+            wakeUp.release();
+        }
+    }
+
+    /* Returns the staging buffer of the calling thread, taking over a released one or allocating one on its first entry. */
+    ThreadLogBuffer *bufferOfThisThread()
+    {
+        if(theThreadLogBuffer.buffer)
+        {
+            return theThreadLogBuffer.buffer;
+        }
+        ThreadLogBuffer *buffer = buffers.load(std::memory_order_acquire);
+        for(; buffer; buffer = buffer->next)
+        {
+            bool isOwned = false;
+            if( ! buffer->isOwned.load(std::memory_order_relaxed)
+                && buffer->isOwned.compare_exchange_strong(isOwned, true, std::memory_order_acquire) )
+            {
+                break;
+            }
+        }
+        if( ! buffer )
+        {
+            buffer = new (std::nothrow) ThreadLogBuffer;
+            if( ! buffer )
+            {
+                return nullptr;
+            }
+            buffer->next = buffers.load(std::memory_order_relaxed);
+            while( ! buffers.compare_exchange_weak(buffer->next, buffer, std::memory_order_release, std::memory_order_relaxed) )
+            {}
+        }
+        theThreadLogBuffer.buffer = buffer;
+        return buffer;
+    }
+
+    bool hasEntries() const
+    {
+        for(const ThreadLogBuffer *buffer = buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next)
+        {
+            if(buffer->front())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(LoggingSystem *loggingSystem)
+    {
+        isWriterThread = true;
+        for(;;)
+        {
+            if(writeBatch(loggingSystem))
+            {
+                continue;
+            }
+            if(isFlushRequested.load())
+            {
+                flushSinks(loggingSystem);
+                isFlushRequested.store(false, std::memory_order_release);
+                continue;
+            }
+            if(isStopping.load())
+            {
+                flushSinks(loggingSystem);
+                break;
+            }
+            isSleeping.store(true);
+            std::atomic_thread_fence(std::memory_order_seq_cst); // Pairs with the fence in wake() of the producers.
+            if( ! hasEntries() && ! isStopping.load() && ! isFlushRequested.load() )
+            {
+                wakeUp.acquire();
+            }
+            else if( ! isSleeping.exchange(false) )
+            {
+                wakeUp.acquire(); // A producer took us off the sleeping list and released a token.
+            }
+        }
+        isWriterThread = false;
+    }
+
+    void flushSinks(LoggingSystem *loggingSystem)
+    {
+        const bool isLocked = loggingSystem->lockDelivery();
+        loggingSystem->flushSinks();
+        if(isLocked)
+        {
+            loggingSystem->unlockDelivery();
+        }
+    }
+
+    bool writeBatch(LoggingSystem *loggingSystem)
+    {
+        const bool isLocked = loggingSystem->lockDelivery();
+        const bool hasWritten = deliverEntries(loggingSystem);
+        if(hasWritten)
+        {
+            loggingSystem->endBatch();
+        }
+        if(isLocked)
+        {
+            loggingSystem->unlockDelivery();
+        }
+        return hasWritten;
+    }
+
+    /*
+     * Merges the staging buffers by timestamp: each round hands the oldest of
+     * their first entries to the sinks. Within a buffer, the entries are in
+     * order already.
+     */
+    bool deliverEntries(LoggingSystem *loggingSystem)
+    {
+        bool hasWritten = false;
+        for(;;)
+        {
+            ThreadLogBuffer *oldestBuffer = nullptr;
+            const LogEntry *oldestEntry = nullptr;
+            for(ThreadLogBuffer *buffer = buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next)
+            {
+                const LogEntry *entry = buffer->front();
+                if( entry && ( ! oldestEntry || (entry->timestamp() < oldestEntry->timestamp()) ) )
+                {
+                    oldestBuffer = buffer;
+                    oldestEntry = entry;
+                }
+            }
+            if( ! oldestEntry )
+            {
+                break;
+            }
+            loggingSystem->deliver(*oldestEntry, true);
+            oldestBuffer->pop();
+            hasWritten = true;
+        }
+
+        const uint64_t droppedNow = dropped.load(std::memory_order_relaxed);
+        if(droppedNow != droppedReported)
+        {
+            LogEntry le(__LINE__, SILICA_SOURCE_FILE_NAME);
+            le.format("%" PRIu64 " entries dropped", droppedNow - droppedReported);
+            le.setType(LogEntry::Type::Warning);
+            loggingSystem->deliver(le);
+            droppedReported = droppedNow;
+            hasWritten = true;
+        }
+        return hasWritten;
+    }
+};
+
+/// \endcond
+
+namespace
+{
+
+AsynchronousLogWriter &theWriter()
+{
+    static AsynchronousLogWriter writer;
+    return writer;
+}
+
+void stopAsynchronousLoggingAtExit()
+{
+    LoggingSystem::instance()->stopAsynchronous();
+}
+
+}
+
+bool LoggingSystem::startAsynchronous(QueuePolicy policy)
+{
+    if(d.writer.load())
+    {
+        return false;
+    }
+
+    // Constructed before the exit handler is registered, so it is destroyed after the handler joined its thread.
+    AsynchronousLogWriter &writer = theWriter();
+
+    static bool isStopRegistered = false;
+    if( ! isStopRegistered )
+    {
+        isStopRegistered = true;
+        ::atexit(stopAsynchronousLoggingAtExit);
+    }
+
+    writer.policy = policy;
+    writer.isStopping.store(false);
+    writer.isSleeping.store(false);
+    writer.isFlushRequested.store(false);
+    writer.thread = std::thread([&writer, this](){ writer.run(this); });
+    d.writer.store(&writer);
+    return true;
+}
+
+void LoggingSystem::stopAsynchronous()
+{
+    if(isWriterThread)
+    {
+        return;
+    }
+    AsynchronousLogWriter *writer = d.writer.exchange(nullptr);
+    if( ! writer )
+    {
+        return;
+    }
+    writer->isStopping.store(true);
+    writer->wake();
+    writer->thread.join();
+}
+
+bool LoggingSystem::isAsynchronous() const
+{
+    return d.writer.load() != nullptr;
+}
+
+uint64_t LoggingSystem::droppedEntries() const
+{
+    return theWriter().dropped.load(std::memory_order_relaxed);
+}
+
+bool LoggingSystem::enqueue(const LogEntry &entry)
+{
+    AsynchronousLogWriter *writer = d.writer.load(std::memory_order_acquire);
+    if( ! writer || isWriterThread )
+    {
+        return false; // Entries logged by the sink itself are delivered right away.
+    }
+    ThreadLogBuffer *buffer = writer->bufferOfThisThread();
+    if( ! buffer )
+    {
+        return false;
+    }
+
+    deliverToSynchronousSinks(entry);
+    while( ! buffer->tryPush(entry) )
+    {
+        if(writer->policy == QueuePolicy::Drop)
+        {
+            writer->dropped.fetch_add(1, std::memory_order_relaxed);
+            writer->wake();
+            return true;
+        }
+        writer->wake();
+        std::this_thread::yield();
+    }
+    writer->wake();
+    return true;
+}
+
+void LoggingSystem::deliverToSynchronousSinks(const LogEntry &entry)
+{
+    size_t first = 0;
+    while( (first < d.sinkCount) && ! (d.sinks[first]->d.isSynchronous && (entry.type() >= d.sinks[first]->d.level)) )
+    {
+        first++;
+    }
+    if(first == d.sinkCount)
+    {
+        return; // The common case, formatting nothing
+    }
+    const LogRecord record(entry);
+    for(size_t i = first; i < d.sinkCount; i++)
+    {
+        LogSink *sink = d.sinks[i];
+        if(sink->d.isSynchronous && (entry.type() >= sink->d.level))
+        {
+            sink->sinkRecord(record);
+        }
+    }
+}
+
+bool LoggingSystem::waitForWriter()
+{
+    AsynchronousLogWriter *writer = d.writer.load(std::memory_order_acquire);
+    if( ! writer )
+    {
+        return false;
+    }
+    if(isWriterThread)
+    {
+        return true;
+    }
+    for(ThreadLogBuffer *buffer = writer->buffers.load(std::memory_order_acquire); buffer; buffer = buffer->next)
+    {
+        const size_t target = buffer->pushed();
+        while( (buffer->popped() < target) && d.writer.load() )
+        {
+            writer->wake();
+            std::this_thread::yield();
+        }
+    }
+    // Sinks flushing only every so many entries may still hold some. Only the writer thread may touch them.
+    writer->isFlushRequested.store(true);
+    while(writer->isFlushRequested.load(std::memory_order_acquire) && d.writer.load())
+    {
+        writer->wake();
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,153 @@
+#include <silica/BinaryLog.h>
+#include <silica/Atomic.h>
+
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+#include <thread>
+#endif
+
+namespace Silica
+{
+
+namespace
+{
+
+Atomic<const LogSite*> lastSite{nullptr};
+Atomic<uint32_t> siteCount{0};
+uint32_t sitesWritten = 0;  // Only touched by the draining thread
+
+/*
+ * Recording goes to buffers[state >> 32 & 1], at offset state & 0xFFFFFFFF.
+ * A writer reserves its bytes by advancing the offset, and adds them to the
+ * committed count of the buffer once written. drain() flips to the other
+ * buffer, and waits until the committed count of the previous buffer
+ * reaches the offset it flipped at, i.e. until every reserved record there
+ * is complete.
+ */
+Atomic<uint64_t> state{0};
+Atomic<uint32_t> committed[2] = {};
+Atomic<uint64_t> dropped{0};
+alignas(8) uint8_t buffers[2][SILICA_BINARY_LOG_BUFFER_SIZE];
+
+void writeString(FILE *file, const char *string)
+{
+    const uint16_t length = static_cast<uint16_t>(strlen(string));
+    fwrite(&length, sizeof(length), 1, file);
+    fwrite(string, 1, length, file);
+}
+
+size_t writeSite(FILE *file, const LogSite &site)
+{
+    const uint8_t tag = BinaryLog::siteTag;
+    const uint32_t id = site.id();
+    const uint32_t line = site.line();
+    const uint8_t type = static_cast<uint8_t>(site.type());
+    fwrite(&tag, sizeof(tag), 1, file);
+    fwrite(&id, sizeof(id), 1, file);
+    fwrite(&line, sizeof(line), 1, file);
+    fwrite(&type, sizeof(type), 1, file);
+    writeString(file, site.file());
+    writeString(file, site.formatString());
+    writeString(file, site.argumentTypes());
+    return sizeof(tag) + sizeof(id) + sizeof(line) + sizeof(type) + 3 * sizeof(uint16_t)
+           + strlen(site.file()) + strlen(site.formatString()) + strlen(site.argumentTypes());
+}
+
+}
+
+LogSite::LogSite(const char *formatString, const char *file, uint32_t line, LogEntry::Type type, const char *argumentTypes)
+{
+    d.formatString = formatString;
+    d.file = file;
+    d.argumentTypes = argumentTypes;
+    d.line = line;
+    d.type = type;
+    d.id = siteCount.fetchAdd(1);
+    d.next = lastSite.load(std::memory_order_relaxed);
+    while( ! lastSite.compareExchangeWeak(d.next, this, std::memory_order_release, std::memory_order_relaxed) ) {}
+}
+
+uint8_t *BinaryLog::reserve(size_t size)
+{
+    uint64_t current = state.load(std::memory_order_relaxed);
+    for(;;)
+    {
+        const uint64_t offset = current & 0xFFFFFFFFu;
+        if(offset + size > SILICA_BINARY_LOG_BUFFER_SIZE)
+        {
+            dropped.fetchAdd(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        if(state.compareExchangeWeak(current, current + size, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            return &buffers[(current >> 32) & 1][offset];
+        }
+    }
+}
+
+void BinaryLog::commit(const uint8_t *record, size_t size)
+{
+    const size_t index = (record >= buffers[1]) ? 1 : 0;
+    committed[index].fetchAdd(static_cast<uint32_t>(size), std::memory_order_release);
+}
+
+size_t BinaryLog::drain(FILE *file, bool writeAllSites)
+{
+    uint64_t previous = state.load(std::memory_order_relaxed);
+    while( ! state.compareExchangeWeak(previous, ((previous >> 32) + 1) << 32, std::memory_order_relaxed) ) {}
+    const size_t index = (previous >> 32) & 1;
+    const uint32_t length = static_cast<uint32_t>(previous & 0xFFFFFFFFu);
+    while(committed[index].load(std::memory_order_acquire) != length)
+    {
+        // A writer is between reserve() and commit(). Without threads this cannot happen, as interrupts complete before returning.
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+        std::this_thread::yield();
+#endif
+    }
+
+    size_t written = 0;
+    fwrite(segmentMagic, sizeof(segmentMagic), 1, file);
+    written += sizeof(segmentMagic);
+
+    // Every site referred to by the records is linked by now, as it was constructed before its first record was committed.
+    const uint32_t firstSite = writeAllSites ? 0 : sitesWritten;
+    const uint32_t siteEnd = siteCount.load(std::memory_order_acquire);
+    uint32_t sitesFound = 0;
+    for(const LogSite *site = lastSite.load(std::memory_order_acquire); site; site = site->d.next)
+    {
+        if( (site->id() >= firstSite) && (site->id() < siteEnd) )
+        {
+            written += writeSite(file, *site);
+            sitesFound++;
+        }
+    }
+    if(sitesFound == siteEnd - firstSite)
+    {
+        sitesWritten = siteEnd;
+    }
+    else
+    {
+        sitesWritten = firstSite; // A site is still registering, write them again next time.
+    }
+
+    if(length)
+    {
+        const uint8_t tag = recordsTag;
+        fwrite(&tag, sizeof(tag), 1, file);
+        fwrite(&length, sizeof(length), 1, file);
+        fwrite(buffers[index], 1, length, file);
+        written += sizeof(tag) + sizeof(length) + length;
+    }
+    committed[index].store(0, std::memory_order_relaxed);
+
+    const uint8_t tag = endTag;
+    fwrite(&tag, sizeof(tag), 1, file);
+    written += sizeof(tag);
+    return written;
+}
+
+uint64_t BinaryLog::droppedRecords()
+{
+    return dropped.load(std::memory_order_relaxed);
+}
+
+}
@@ -1,6 +1,7 @@
 #include <silica/CoarseTimer.h>
 #include <silica/Application.h>
 #include <silica/LoggingSystem.h>
+#include <silica/Trace.h>
 namespace Silica
 {
 
@@ -19,12 +20,19 @@ void CoarseTimer::visit()
     MicroSeconds now = Application::instance()->microsecondsSinceStart();
     if( now >= d.nextTimeOut )
     {
-        emit this->triggered();
+        {
+            TraceScope trace("CoarseTimer::triggered", this);
+            emit this->triggered();
+        }
         if(d.type == Silica::CoarseTimer::Type::Repeated)
         {
             restart();
         }
     }
+    if(d.isRunning)
+    {
+        wakeAt(d.nextTimeOut);
+    }
 }
 
 
@@ -47,11 +55,13 @@ void CoarseTimer::start()
 {
     d.isRunning = true;
     restart();
+    wakeAt(d.nextTimeOut);
 }
 
 void CoarseTimer::stop()
 {
     d.isRunning = false;
+    cancelWakeAt();
 }
 
 bool CoarseTimer::isRunning() const
@@ -0,0 +1,294 @@
+#include <silica/Coroutine.h>
+#include <silica/LoggingSystem.h>
+#include <silica/Mutex.h>
+#include <stdlib.h>
+
+namespace Silica
+{
+
+namespace
+{
+
+constexpr size_t smallestFrameClass = 64;
+
+size_t sizeClassOf(size_t size)
+{
+    size_t index = 0;
+    size_t classSize = smallestFrameClass;
+    while(classSize < size)
+    {
+        classSize *= 2;
+        index++;
+    }
+    return index;
+}
+
+constexpr size_t sizeClassCount()
+{
+    size_t count = 1;
+    for(size_t classSize = smallestFrameClass; classSize < SILICA_COROUTINE_FRAME_MAX_POOLED_SIZE; classSize *= 2)
+    {
+        count++;
+    }
+    return count;
+}
+
+struct FreeFrame
+{
+    FreeFrame *next;
+};
+
+struct FramePool
+{
+    FreeFrame *freeLists[sizeClassCount()] = {};
+    size_t heapAllocations = 0;
+
+    ~FramePool()
+    {
+        for(FreeFrame *&list : freeLists)
+        {
+            while(list)
+            {
+                FreeFrame *next = list->next;
+                free(list);
+                list = next;
+            }
+        }
+    }
+};
+
+thread_local FramePool framePool;
+
+/*
+ * Blocks that may be released on another thread than the one that allocated
+ * them. A per thread pool would fill up on the releasing thread and never be
+ * drawn from, so these share one pool across all threads.
+ */
+FramePool sharedFramePool;
+Mutex sharedFramePoolMutex("CoroutineFrameAllocator");
+
+FreeFrame *takeFrame(FramePool &pool, size_t index)
+{
+    FreeFrame *frame = pool.freeLists[index];
+    if(frame)
+    {
+        pool.freeLists[index] = frame->next;
+    }
+    return frame;
+}
+
+void putFrame(FramePool &pool, size_t index, void *frame)
+{
+    FreeFrame *freeFrame = static_cast<FreeFrame*>(frame);
+    freeFrame->next = pool.freeLists[index];
+    pool.freeLists[index] = freeFrame;
+}
+
+}
+
+void *CoroutineFrameAllocator::allocate(size_t size)
+{
+    if(size > SILICA_COROUTINE_FRAME_MAX_POOLED_SIZE)
+    {
+        framePool.heapAllocations++;
+        return malloc(size);
+    }
+
+    const size_t index = sizeClassOf(size);
+    if(FreeFrame *frame = takeFrame(framePool, index))
+    {
+        return frame;
+    }
+    framePool.heapAllocations++;
+    return malloc(smallestFrameClass << index);
+}
+
+void CoroutineFrameAllocator::deallocate(void *frame, size_t size)
+{
+    if(size > SILICA_COROUTINE_FRAME_MAX_POOLED_SIZE)
+    {
+        free(frame);
+        return;
+    }
+    putFrame(framePool, sizeClassOf(size), frame);
+}
+
+void *CoroutineFrameAllocator::allocateShared(size_t size)
+{
+    if(size > SILICA_COROUTINE_FRAME_MAX_POOLED_SIZE)
+    {
+        framePool.heapAllocations++;
+        return malloc(size);
+    }
+
+    const size_t index = sizeClassOf(size);
+    {
+        MutexLocker locker(sharedFramePoolMutex);
+        if(FreeFrame *frame = takeFrame(sharedFramePool, index))
+        {
+            return frame;
+        }
+    }
+    framePool.heapAllocations++;
+    return malloc(smallestFrameClass << index);
+}
+
+void CoroutineFrameAllocator::deallocateShared(void *frame, size_t size)
+{
+    if(size > SILICA_COROUTINE_FRAME_MAX_POOLED_SIZE)
+    {
+        free(frame);
+        return;
+    }
+    const size_t index = sizeClassOf(size);
+    MutexLocker locker(sharedFramePoolMutex);
+    putFrame(sharedFramePool, index, frame);
+}
+
+size_t CoroutineFrameAllocator::heapAllocationCount()
+{
+    return framePool.heapAllocations;
+}
+
+void Coroutine::promise_type::unhandled_exception()
+{
+    FATAL("Unhandled exception in Coroutine");
+}
+
+Coroutine & Coroutine::operator=(Coroutine &&other) noexcept
+{
+    if(this != &other)
+    {
+        release();
+        handle = other.handle;
+        other.handle = nullptr;
+    }
+    return *this;
+}
+
+Coroutine::~Coroutine()
+{
+    release();
+}
+
+void Coroutine::release()
+{
+    if( ! handle )
+    {
+        return;
+    }
+    if(handle.promise().isFinished)
+    {
+        handle.destroy();
+    }
+    else
+    {
+        handle.promise().isDetached = true;
+    }
+    handle = nullptr;
+}
+
+std::coroutine_handle<> Coroutine::FinalAwaiter::await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+{
+    promise_type &promise = handle.promise();
+    promise.isFinished = true;
+    if(promise.continuation)
+    {
+        return promise.continuation;
+    }
+    if(promise.isDetached)
+    {
+        handle.destroy();
+    }
+    return std::noop_coroutine();
+}
+
+void resumeOnLoop(std::coroutine_handle<> handle)
+{
+    Application::instance()->invokeOnLoop([handle](){
+        handle.resume();
+    });
+}
+
+SleepAwaiter::SleepAwaiter(MicroSeconds duration)
+    : deadline(Application::instance()->microsecondsSinceStart() + duration)
+{}
+
+bool SleepAwaiter::await_ready() const
+{
+    return uint64_t(Application::instance()->microsecondsSinceStart()) >= uint64_t(deadline);
+}
+
+void SleepAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    this->handle = handle;
+    wakeAt(deadline);
+}
+
+void SleepAwaiter::visit()
+{
+    if( ! handle )
+    {
+        return; // Visited once after construction, before being awaited.
+    }
+    if( ! await_ready() )
+    {
+        wakeAt(deadline);
+        return;
+    }
+    resumeOnLoop(handle);
+    handle = nullptr;
+}
+
+ReadableAwaiter::~ReadableAwaiter()
+{
+    if(isWaitingForDataReady)
+    {
+        device.dataReady.removeWaiter(this);
+    }
+}
+
+void ReadableAwaiter::await_suspend(std::coroutine_handle<> handle)
+{
+    this->handle = handle;
+    waitForData();
+}
+
+void ReadableAwaiter::signalEmitted(IODevice *, Array<Byte> *)
+{
+    isWaitingForDataReady = false;
+    wake();
+}
+
+void ReadableAwaiter::visit()
+{
+    if( ! handle )
+    {
+        return; // Visited once after construction, before being awaited.
+    }
+    if( ! await_ready() )
+    {
+        waitForData();
+        return;
+    }
+    if(isWaitingForDataReady)
+    {
+        device.dataReady.removeWaiter(this);
+        isWaitingForDataReady = false;
+    }
+    resumeOnLoop(handle);
+    handle = nullptr;
+}
+
+void ReadableAwaiter::waitForData()
+{
+    if( ! isWaitingForDataReady )
+    {
+        device.dataReady.addWaiter(this);
+        isWaitingForDataReady = true;
+    }
+    // Not every IODevice emits dataReady, so check back now and then.
+    wakeAt(Application::instance()->microsecondsSinceStart() + MicroSeconds(SILICA_COROUTINE_READABLE_POLL_INTERVAL));
+}
+
+}
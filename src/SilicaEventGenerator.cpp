@@ -1,16 +1,90 @@
 #include <silica/EventGenerator.h>
 #include <silica/Application.h>
+
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+#include <thread>
+#endif
+
 namespace Silica
 {
 
 EventGenerator::EventGenerator()
 {
-    Application::instance()->d.eventGenerators.append(this);
+    if(Application::instance()->registerEventGenerator(this))
+    {
+        wake();
+    }
 }
 
 EventGenerator::~EventGenerator()
 {
-//    Application::instance()->d.eventGenerators.remove(this);
+    if(Application::theApplicationInstance)
+    {
+        Application::theApplicationInstance->cancelWakeAt(this);
+        // Unregistering first makes any wake() starting from now on do nothing, and the ones already running are waited for,
+        // so nothing can push this EventGenerator to the ready list once it has been forgotten.
+        Application::theApplicationInstance->unregisterEventGenerator(this);
+        waitForWakesInProgress();
+        Application::theApplicationInstance->forgetReady(this);
+    }
+}
+
+void EventGenerator::wake()
+{
+    d.wakesInProgress.fetchAdd(1, std::memory_order_seq_cst);
+    if( d.isRegistered.load(std::memory_order_seq_cst)
+        && ! d.isReady.exchange(true, std::memory_order_acq_rel) // Already in the ready list if it was ready.
+        && Application::theApplicationInstance )
+    {
+        Application::theApplicationInstance->markReady(this);
+    }
+    d.wakesInProgress.fetchSub(1, std::memory_order_release);
+}
+
+void EventGenerator::waitForWakesInProgress()
+{
+    for(unsigned polls = 0; d.wakesInProgress.load(std::memory_order_acquire) != 0; polls++)
+    {
+        // A wake() on another thread is between checking the registration and pushing to the ready list. That takes a few instructions,
+        // unless that thread was preempted, which only it running again resolves.
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+        if(polls >= 64)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+#endif
+        cpuRelax();
+    }
+}
+
+DurationStatistics EventGenerator::visitStatistics() const
+{
+    DurationStatistics result;
+    d.visitCounters.snapshot(result);
+    return result;
+}
+
+void EventGenerator::resetVisitStatistics()
+{
+    d.visitCounters.reset();
+}
+
+void EventGenerator::wakeAt(MicroSeconds time)
+{
+    if( ! d.isRegistered.load(std::memory_order_relaxed) )
+    {
+        return;
+    }
+    Application::instance()->scheduleWakeAt(this, time);
+}
+
+void EventGenerator::cancelWakeAt()
+{
+    if(Application::theApplicationInstance)
+    {
+        Application::theApplicationInstance->cancelWakeAt(this);
+    }
 }
 
 
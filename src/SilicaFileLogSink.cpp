@@ -0,0 +1,220 @@
+#include <silica/FileLogSink.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace Silica
+{
+
+namespace
+{
+
+constexpr size_t theLineMaxLength = (LogRecord::textMaxLength > LogFields::jsonMaxLength + 1) ? LogRecord::textMaxLength
+                                                                                             : LogFields::jsonMaxLength + 1;
+
+}
+
+FileLogSink::FileLogSink(const char *path)
+{
+    const size_t length = strlen(path);
+    const size_t bytesToCopy = (length < FILENAME_MAX) ? length : FILENAME_MAX;
+    memcpy(d.path, path, bytesToCopy);
+    d.path[bytesToCopy] = 0;
+
+    const int64_t size = platformOpen();
+    d.fileSize = (size < 0) ? 0 : static_cast<uint64_t>(size);
+    setFlushInterval(SIZE_MAX);
+}
+
+FileLogSink::~FileLogSink()
+{
+    writeChunks();
+    if(d.syncPolicy != SyncPolicy::Never)
+    {
+        platformSync();
+    }
+    platformClose();
+}
+
+bool FileLogSink::isOpen() const
+{
+    return d.handle != -1;
+}
+
+void FileLogSink::sinkRecord(const LogRecord &record)
+{
+    if(d.format == Format::JsonLines)
+    {
+        char json[LogFields::jsonMaxLength + 2];
+        size_t length = LogFields::renderJson(record.entry(), json, sizeof(json) - 1);
+        json[length++] = '\n';
+        append(json, length);
+    }
+    else
+    {
+        append(record.text(), record.textLength());
+    }
+
+    const bool isLastChunkFull = (d.currentChunk == SILICA_FILE_LOG_SINK_CHUNKS - 1)
+                                 && (d.chunkLengths[d.currentChunk] + theLineMaxLength > SILICA_FILE_LOG_SINK_CHUNK_SIZE);
+    if( isLastChunkFull || (platformMilliseconds() - d.oldestEntryTime >= d.flushDelay) )
+    {
+        writeChunks();
+    }
+}
+
+void FileLogSink::flush()
+{
+    writeChunks();
+    if(d.syncPolicy == SyncPolicy::OnFlush)
+    {
+        platformSync();
+    }
+}
+
+void FileLogSink::append(const char *text, size_t length)
+{
+    if(length > SILICA_FILE_LOG_SINK_CHUNK_SIZE)
+    {
+        length = SILICA_FILE_LOG_SINK_CHUNK_SIZE;
+    }
+    if(d.chunkLengths[d.currentChunk] + length > SILICA_FILE_LOG_SINK_CHUNK_SIZE)
+    {
+        if(d.currentChunk == SILICA_FILE_LOG_SINK_CHUNKS - 1)
+        {
+            writeChunks();
+        }
+        else
+        {
+            d.currentChunk++;
+        }
+    }
+    if( (d.currentChunk == 0) && (d.chunkLengths[0] == 0) )
+    {
+        d.oldestEntryTime = platformMilliseconds();
+    }
+    memcpy(d.chunks[d.currentChunk] + d.chunkLengths[d.currentChunk], text, length);
+    d.chunkLengths[d.currentChunk] += length;
+}
+
+void FileLogSink::writeChunks()
+{
+    Segment segments[SILICA_FILE_LOG_SINK_CHUNKS];
+    size_t count = 0;
+    uint64_t bytes = 0;
+    for(size_t i = 0; i <= d.currentChunk; i++)
+    {
+        if(d.chunkLengths[i])
+        {
+            segments[count].data = d.chunks[i];
+            segments[count].length = d.chunkLengths[i];
+            bytes += d.chunkLengths[i];
+            count++;
+        }
+        d.chunkLengths[i] = 0;
+    }
+    d.currentChunk = 0;
+    if( (count == 0) || ! isOpen() )
+    {
+        return;
+    }
+
+    platformWrite(segments, count);
+    d.writeCalls++;
+    d.fileSize += bytes;
+    if(d.maximumFileSize && (d.fileSize >= d.maximumFileSize))
+    {
+        rotate();
+    }
+}
+
+void FileLogSink::rotate()
+{
+    if(d.syncPolicy != SyncPolicy::Never)
+    {
+        platformSync();
+    }
+    platformClose();
+
+    // gateway.log.4 -> gateway.log.5, ..., gateway.log -> gateway.log.1
+    char from[FILENAME_MAX + 16];
+    char to[FILENAME_MAX + 16];
+    for(unsigned i = d.maximumFiles; i > 0; i--)
+    {
+        snprintf(to, sizeof(to), "%s.%u", d.path, i);
+        if(i > 1)
+        {
+            snprintf(from, sizeof(from), "%s.%u", d.path, i - 1);
+        }
+        else
+        {
+            snprintf(from, sizeof(from), "%s", d.path);
+        }
+        ::remove(to);   // rename() does not replace files on every platform
+        ::rename(from, to);
+    }
+    if(d.maximumFiles == 0)
+    {
+        ::remove(d.path);
+    }
+
+    const int64_t size = platformOpen();
+    d.fileSize = (size < 0) ? 0 : static_cast<uint64_t>(size);
+}
+
+void FileLogSink::setMaximumFileSize(uint64_t bytes)
+{
+    d.maximumFileSize = bytes;
+}
+
+uint64_t FileLogSink::maximumFileSize() const
+{
+    return d.maximumFileSize;
+}
+
+void FileLogSink::setMaximumFiles(unsigned count)
+{
+    d.maximumFiles = count;
+}
+
+unsigned FileLogSink::maximumFiles() const
+{
+    return d.maximumFiles;
+}
+
+void FileLogSink::setFlushDelay(MilliSeconds delay)
+{
+    d.flushDelay = static_cast<uint64_t>(MicroSeconds(delay)) / 1000;
+}
+
+MilliSeconds FileLogSink::flushDelay() const
+{
+    return MilliSeconds(d.flushDelay);
+}
+
+void FileLogSink::setSyncPolicy(SyncPolicy policy)
+{
+    d.syncPolicy = policy;
+}
+
+FileLogSink::SyncPolicy FileLogSink::syncPolicy() const
+{
+    return d.syncPolicy;
+}
+
+void FileLogSink::setFormat(Format format)
+{
+    d.format = format;
+}
+
+FileLogSink::Format FileLogSink::format() const
+{
+    return d.format;
+}
+
+uint64_t FileLogSink::writeCalls() const
+{
+    return d.writeCalls;
+}
+
+}
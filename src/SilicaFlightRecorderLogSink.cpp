@@ -0,0 +1,109 @@
+#include <silica/FlightRecorderLogSink.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace Silica
+{
+
+namespace
+{
+
+constexpr size_t theRecordSize = FlightRecorderLogSink::recordSize(SILICA_LOGENTRY_FILENAME_MAX_LENGTH, SILICA_LOGENTRY_MESSAGE_MAX_LENGTH);
+
+static_assert(sizeof(FlightRecorderHeader) <= FlightRecorderLogSink::headerSize, "The header must fit into its space");
+
+}
+
+FlightRecorderLogSink::FlightRecorderLogSink(const char *path, uint32_t recordCount)
+{
+    const size_t length = strlen(path);
+    const size_t bytesToCopy = (length < FILENAME_MAX) ? length : FILENAME_MAX;
+    memcpy(d.path, path, bytesToCopy);
+    d.path[bytesToCopy] = 0;
+    setFlushInterval(SIZE_MAX);
+    setSynchronous(true); // Staged entries would be lost in exactly the crash the file is for
+
+    if(recordCount == 0)
+    {
+        return;
+    }
+    void *mapping = platformMap(headerSize + size_t(recordCount) * theRecordSize);
+    if( ! mapping )
+    {
+        return;
+    }
+    d.header = static_cast<FlightRecorderHeader*>(mapping);
+    d.records = static_cast<uint8_t*>(mapping) + headerSize;
+    d.recordCount = recordCount;
+
+    const bool isCompatible = (memcmp(d.header->magic, magic, sizeof(magic)) == 0)
+                              && (d.header->version == version)
+                              && (d.header->recordCount == recordCount)
+                              && (d.header->recordSize == theRecordSize)
+                              && (d.header->fileNameLength == SILICA_LOGENTRY_FILENAME_MAX_LENGTH)
+                              && (d.header->messageLength == SILICA_LOGENTRY_MESSAGE_MAX_LENGTH);
+    if( ! isCompatible )
+    {
+        memset(mapping, 0, d.size);
+        d.header->version = version;
+        d.header->recordCount = recordCount;
+        d.header->recordSize = theRecordSize;
+        d.header->fileNameLength = SILICA_LOGENTRY_FILENAME_MAX_LENGTH;
+        d.header->messageLength = SILICA_LOGENTRY_MESSAGE_MAX_LENGTH;
+        d.header->nextSequence.store(0, std::memory_order_relaxed);
+        memcpy(d.header->magic, magic, sizeof(magic)); // Last, so a half initialized file is not mistaken for a valid one
+    }
+}
+
+FlightRecorderLogSink::~FlightRecorderLogSink()
+{
+    platformUnmap();
+}
+
+bool FlightRecorderLogSink::isOpen() const
+{
+    return d.header != nullptr;
+}
+
+FlightRecord *FlightRecorderLogSink::record(uint64_t sequence) const
+{
+    return reinterpret_cast<FlightRecord*>(d.records + (sequence % d.recordCount) * theRecordSize);
+}
+
+void FlightRecorderLogSink::sinkEntry(const LogEntry &entry)
+{
+    if( ! d.header )
+    {
+        return;
+    }
+    const uint64_t sequence = d.header->nextSequence.fetch_add(1, std::memory_order_relaxed);
+    FlightRecord *target = record(sequence);
+
+    // Marked empty while written, so a crash in between leaves no torn record behind.
+    target->sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    target->line = static_cast<uint32_t>(entry.originatingLine());
+    target->type = static_cast<uint8_t>(entry.type());
+    char *text = reinterpret_cast<char*>(target + 1);
+    strncpy(text, entry.originatingFile(), SILICA_LOGENTRY_FILENAME_MAX_LENGTH); // Pads with nulls, so nothing of an older record remains
+    text[SILICA_LOGENTRY_FILENAME_MAX_LENGTH] = 0;
+    memcpy(text + SILICA_LOGENTRY_FILENAME_MAX_LENGTH + 1, entry.message(), SILICA_LOGENTRY_MESSAGE_MAX_LENGTH + 1);
+
+    target->sequence.store(sequence + 1, std::memory_order_release);
+}
+
+void FlightRecorderLogSink::syncToStorage()
+{
+    if(d.header)
+    {
+        platformSync();
+    }
+}
+
+uint64_t FlightRecorderLogSink::recordedEntries() const
+{
+    return d.header ? d.header->nextSequence.load(std::memory_order_relaxed) : 0;
+}
+
+}
@@ -0,0 +1,59 @@
+#include <silica/Future.h>
+#include <silica/Application.h>
+
+namespace Silica
+{
+
+void FutureStateBase::releaseReference()
+{
+    if(d.references.fetchSub(1, std::memory_order_acq_rel) != 1)
+    {
+        return;
+    }
+    const size_t size = allocatedSize();
+    this->~FutureStateBase();
+    CoroutineFrameAllocator::deallocateShared(this, size);
+}
+
+void FutureStateBase::publish()
+{
+    if(d.flags.fetchOr(HasValue, std::memory_order_acq_rel) & HasContinuation)
+    {
+        scheduleContinuation();
+    }
+}
+
+void FutureStateBase::breakPromise()
+{
+    if(d.flags.fetchOr(IsBroken, std::memory_order_acq_rel) & HasContinuation)
+    {
+        d.continuation.reset();
+        releaseReference();
+    }
+}
+
+void FutureStateBase::attachContinuation(Task continuation)
+{
+    d.continuation = std::move(continuation);
+    const unsigned previous = d.flags.fetchOr(HasContinuation, std::memory_order_acq_rel);
+    if(previous & HasValue)
+    {
+        scheduleContinuation();
+    }
+    else if(previous & IsBroken)
+    {
+        d.continuation.reset();
+        releaseReference();
+    }
+}
+
+void FutureStateBase::scheduleContinuation()
+{
+    Application::instance()->invokeOnLoop([this](){
+        d.continuation();
+        d.continuation.reset();
+        releaseReference();
+    });
+}
+
+}
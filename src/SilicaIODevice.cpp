@@ -5,10 +5,10 @@ namespace Silica
 
 IODevice::IODevice()
  :
-    close(std::bind(&IODevice::closeImplementation, this))
-    , open(std::bind(&IODevice::openImplementation, this, std::placeholders::_1))
-    , writeArray(std::bind(&IODevice::writeArrayImplementation, this, std::placeholders::_1))
-    , writeByte(std::bind(&IODevice::writeByteImplementation, this, std::placeholders::_1))
+    close(Slot<>::fromMethod<&IODevice::closeImplementation>(this))
+    , open(Slot<OpenMode>::fromMethod<&IODevice::openImplementation>(this))
+    , writeArray(Slot<Array<Byte> *>::fromMethod<&IODevice::writeArrayImplementation>(this))
+    , writeByte(Slot<Byte>::fromMethod<&IODevice::writeByteImplementation>(this))
 {
 }
 
@@ -24,6 +24,7 @@ Silica::LogEntry::~LogEntry()
 
 Silica::LogEntry::LogEntry()
 {
+    d.message[0] = 0;
     setType(Type::Log);
 }
 
@@ -38,80 +39,53 @@ void Silica::LogEntry::setType(Type type)
 }
 
 
+Silica::LogEntry::LogEntry(size_t line, const SourceFileName &originatingFile)
+    : LogEntry()
+{
+    d.originatingLine = line;
+    setOriginatingFile(originatingFile);
+    stamp();
+}
+
 Silica::LogEntry::LogEntry(size_t line, const char *originatingFile)
     : LogEntry()
 {
     d.originatingLine = line;
     setOriginatingFile(originatingFile);
+    stamp();
+}
 
+void Silica::LogEntry::stamp()
+{
+    d.timestamp = platformTimestamp();
+    d.threadId = platformThreadId();
 }
 
-void Silica::LogEntry::setOriginatingFile(const char *originatingFile)
+void Silica::LogEntry::setOriginatingFile(const SourceFileName &originatingFile)
 {
-    ssize_t lenght_of_filename = strlen(originatingFile);
-    ssize_t index_first_character_after_last_path_separator = lenght_of_filename-1;
-    while(index_first_character_after_last_path_separator > 0)
-    {
-        if((originatingFile[index_first_character_after_last_path_separator] == '/' )
-            ||
-            (originatingFile[index_first_character_after_last_path_separator] == '\\' ))
-        {
-            index_first_character_after_last_path_separator++;
-            break;
-        }
-        index_first_character_after_last_path_separator--;
-    }
+    d.originatingFile = originatingFile.name;
+}
 
-    size_t bytesToCopy = lenght_of_filename - index_first_character_after_last_path_separator  ;
-    bool should_elide = false;
-    if(bytesToCopy > SILICA_LOGENTRY_MESSAGE_MAX_LENGTH)
-    {
-        should_elide = true;
-        bytesToCopy = SILICA_LOGENTRY_MESSAGE_MAX_LENGTH;
-    }
+void Silica::LogEntry::setOriginatingFile(const char *originatingFile)
+{
+    // Copied rather than referred to, as the entry may be read by the writer thread after a name built at runtime is gone.
+    SourceFileName::shorten(originatingFile, d.copiedFile);
+    d.originatingFile = nullptr;
+}
 
-    if ( ! should_elide )
-    {
-        memcpy(
-            d.originatingFile,
-            originatingFile+index_first_character_after_last_path_separator ,
-            bytesToCopy);
-        d.originatingFile[bytesToCopy] = 0;
-    }
-    else
+void Silica::LogEntry::setFields(const uint8_t *fields, size_t size)
+{
+    if(size > SILICA_LOGENTRY_FIELDS_MAX_SIZE)
     {
-        const size_t left_part_size = (SILICA_LOGENTRY_FILENAME_MAX_LENGTH-elision_size)/2;
-        const size_t right_part_size = SILICA_LOGENTRY_FILENAME_MAX_LENGTH-elision_size-left_part_size;
-
-        const char * const source_left_part_start = originatingFile+index_first_character_after_last_path_separator;
-        const char * const source_left_part_end = source_left_part_start + left_part_size;
-        const char * const source_right_part_start = originatingFile+(strlen(originatingFile)-right_part_size);
-
-        char * destination_left_part_start = d.originatingFile;
-        char * destination_right_part_start = d.originatingFile + left_part_size+elision_size;
-
-        memcpy(destination_left_part_start, source_left_part_start, left_part_size);
-        memcpy(destination_right_part_start, source_right_part_start, right_part_size);
-
-        d.originatingFile[d.orignatingFileMaxLength] = 0;
-
-        for(size_t i = 0; i < elision_size; i++)
-        {
-            d.originatingFile[left_part_size+i] = '.';
-        }
-
-
-
-
-
+        size = SILICA_LOGENTRY_FIELDS_MAX_SIZE;
     }
-
-
+    memcpy(d.fields, fields, size);
+    d.fieldsSize = static_cast<uint16_t>(size);
 }
 
 const char *Silica::LogEntry::originatingFile() const
 {
-    return d.originatingFile;
+    return d.originatingFile ? d.originatingFile : d.copiedFile;
 }
 
 size_t Silica::LogEntry::format(const char *str, ...)
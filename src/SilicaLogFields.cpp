@@ -0,0 +1,336 @@
+#include <silica/LogFields.h>
+#include <silica/LogRecord.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace Silica
+{
+
+namespace
+{
+
+/* Collects text into a buffer of fixed capacity, cutting what does not fit. */
+struct Output
+{
+    char *data;
+    size_t capacity;
+    size_t length = 0;
+
+    void put(char c)
+    {
+        if(length + 1 < capacity)
+        {
+            data[length++] = c;
+        }
+    }
+
+    void put(const char *text, size_t textLength)
+    {
+        for(size_t i = 0; i < textLength; i++)
+        {
+            put(text[i]);
+        }
+    }
+
+    void print(const char *format, ...)
+    {
+        if(length + 1 >= capacity)
+        {
+            return;
+        }
+        va_list args;
+        va_start(args, format);
+        const int printed = vsnprintf(data + length, capacity - length, format, args);
+        va_end(args);
+        if(printed > 0)
+        {
+            length += (length + printed < capacity) ? static_cast<size_t>(printed) : capacity - 1 - length;
+        }
+    }
+
+    void putJsonString(const char *text, size_t textLength)
+    {
+        put('"');
+        for(size_t i = 0; i < textLength; i++)
+        {
+            const unsigned char c = static_cast<unsigned char>(text[i]);
+            if( (c == '"') || (c == '\\') )
+            {
+                put('\\');
+                put(static_cast<char>(c));
+            }
+            else if(c < 0x20)
+            {
+                print("\\u%04x", c);
+            }
+            else
+            {
+                put(static_cast<char>(c));
+            }
+        }
+        put('"');
+    }
+
+    size_t finish()
+    {
+        if(capacity)
+        {
+            data[length] = 0;
+        }
+        return length;
+    }
+};
+
+void putValue(Output &output, const LogFields::Field &field, bool isJson)
+{
+    switch(field.type)
+    {
+    case LogFields::Type::Signed:
+        output.print("%lld", static_cast<long long>(field.signedValue));
+        break;
+    case LogFields::Type::Unsigned:
+        output.print("%llu", static_cast<unsigned long long>(field.unsignedValue));
+        break;
+    case LogFields::Type::FloatingPoint:
+        if( isJson && ! isfinite(field.floatingPointValue) )
+        {
+            output.put("null", 4);
+        }
+        else
+        {
+            output.print("%.17g", field.floatingPointValue);
+        }
+        break;
+    case LogFields::Type::Boolean:
+        if(field.booleanValue)
+        {
+            output.put("true", 4);
+        }
+        else
+        {
+            output.put("false", 5);
+        }
+        break;
+    case LogFields::Type::String:
+        if(isJson)
+        {
+            output.putJsonString(field.stringValue, field.stringLength);
+        }
+        else
+        {
+            output.put('"');
+            output.put(field.stringValue, field.stringLength);
+            output.put('"');
+        }
+        break;
+    }
+}
+
+}
+
+bool LogFields::Reader::next(Field &field)
+{
+    const uint8_t *cursor = d.cursor;
+    if(cursor >= d.end)
+    {
+        return false;
+    }
+    field.keyLength = *cursor++;
+    field.key = reinterpret_cast<const char*>(cursor);
+    cursor += field.keyLength;
+    if(cursor >= d.end)
+    {
+        d.cursor = d.end;
+        return false;
+    }
+    field.type = static_cast<Type>(*cursor++);
+    field.stringValue = nullptr;
+    field.stringLength = 0;
+    switch(field.type)
+    {
+    case Type::Signed:
+    case Type::Unsigned:
+    {
+        uint64_t value = 0;
+        unsigned shift = 0;
+        while( (cursor < d.end) && (*cursor & 0x80) )
+        {
+            value |= uint64_t(*cursor++ & 0x7f) << shift;
+            shift += 7;
+        }
+        if(cursor >= d.end)
+        {
+            d.cursor = d.end;
+            return false;
+        }
+        value |= uint64_t(*cursor++) << shift;
+        if(field.type == Type::Signed)
+        {
+            field.signedValue = static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+        }
+        else
+        {
+            field.unsignedValue = value;
+        }
+        break;
+    }
+    case Type::FloatingPoint:
+        if(cursor + sizeof(double) > d.end)
+        {
+            d.cursor = d.end;
+            return false;
+        }
+        memcpy(&field.floatingPointValue, cursor, sizeof(double));
+        cursor += sizeof(double);
+        break;
+    case Type::Boolean:
+        if(cursor >= d.end)
+        {
+            d.cursor = d.end;
+            return false;
+        }
+        field.booleanValue = *cursor++ != 0;
+        break;
+    case Type::String:
+        if(cursor >= d.end)
+        {
+            d.cursor = d.end;
+            return false;
+        }
+        field.stringLength = *cursor++;
+        field.stringValue = reinterpret_cast<const char*>(cursor);
+        cursor += field.stringLength;
+        break;
+    default:
+        d.cursor = d.end;
+        return false;
+    }
+    if(cursor > d.end)
+    {
+        d.cursor = d.end;
+        return false;
+    }
+    d.cursor = cursor;
+    return true;
+}
+
+void LogFields::encodeBytes(Encoder &encoder, const char *bytes, size_t length)
+{
+    if(length > 255)
+    {
+        length = 255;
+    }
+    if(encoder.isFull || (encoder.cursor + 1 + length > encoder.end))
+    {
+        encoder.isFull = true;
+        return;
+    }
+    *encoder.cursor++ = static_cast<uint8_t>(length);
+    memcpy(encoder.cursor, bytes, length);
+    encoder.cursor += length;
+}
+
+void LogFields::encodeKey(Encoder &encoder, const char *key)
+{
+    encodeBytes(encoder, key, strlen(key));
+}
+
+void LogFields::encodeVariableLength(Encoder &encoder, Type type, uint64_t value)
+{
+    uint8_t bytes[11];
+    size_t length = 0;
+    bytes[length++] = static_cast<uint8_t>(type);
+    while(value >= 0x80)
+    {
+        bytes[length++] = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    bytes[length++] = static_cast<uint8_t>(value);
+    if(encoder.isFull || (encoder.cursor + length > encoder.end))
+    {
+        encoder.isFull = true;
+        return;
+    }
+    memcpy(encoder.cursor, bytes, length);
+    encoder.cursor += length;
+}
+
+void LogFields::encodeFloatingPoint(Encoder &encoder, double value)
+{
+    if(encoder.isFull || (encoder.cursor + 1 + sizeof(value) > encoder.end))
+    {
+        encoder.isFull = true;
+        return;
+    }
+    *encoder.cursor++ = static_cast<uint8_t>(Type::FloatingPoint);
+    memcpy(encoder.cursor, &value, sizeof(value));
+    encoder.cursor += sizeof(value);
+}
+
+void LogFields::encodeBoolean(Encoder &encoder, bool value)
+{
+    if(encoder.isFull || (encoder.cursor + 2 > encoder.end))
+    {
+        encoder.isFull = true;
+        return;
+    }
+    *encoder.cursor++ = static_cast<uint8_t>(Type::Boolean);
+    *encoder.cursor++ = value ? 1 : 0;
+}
+
+void LogFields::encodeString(Encoder &encoder, const char *value)
+{
+    if(encoder.isFull || (encoder.cursor + 1 > encoder.end))
+    {
+        encoder.isFull = true;
+        return;
+    }
+    *encoder.cursor++ = static_cast<uint8_t>(Type::String);
+    encodeBytes(encoder, value ? value : "", value ? strlen(value) : 0);
+}
+
+size_t LogFields::appendText(const LogEntry &entry, char *text, size_t capacity)
+{
+    Output output{text, capacity};
+    Reader reader(entry);
+    Field field;
+    bool isFirst = true;
+    while(reader.next(field))
+    {
+        if( ! isFirst )
+        {
+            output.put(' ');
+        }
+        isFirst = false;
+        output.put(field.key, field.keyLength);
+        output.put('=');
+        putValue(output, field, false);
+    }
+    return output.finish();
+}
+
+size_t LogFields::renderJson(const LogEntry &entry, char *json, size_t capacity)
+{
+    Output output{json, capacity};
+    output.print("{\"type\":\"%c\",\"time\":%llu,\"thread\":%lu,\"line\":%zu,\"file\":", LogRecord::indicatorOf(entry.type()),
+                 static_cast<unsigned long long>(entry.timestamp()), static_cast<unsigned long>(entry.threadId()), entry.originatingLine());
+    output.putJsonString(entry.originatingFile(), strnlen(entry.originatingFile(), SILICA_LOGENTRY_FILENAME_MAX_LENGTH));
+    output.put(",\"message\":", 11);
+    output.putJsonString(entry.message(), strlen(entry.message()));
+
+    Reader reader(entry);
+    Field field;
+    while(reader.next(field))
+    {
+        output.put(',');
+        output.putJsonString(field.key, field.keyLength);
+        output.put(':');
+        putValue(output, field, true);
+    }
+    output.put('}');
+    return output.finish();
+}
+
+}
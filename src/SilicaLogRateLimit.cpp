@@ -0,0 +1,68 @@
+#include <silica/LogRateLimit.h>
+
+namespace Silica
+{
+
+namespace
+{
+
+Atomic<LogRateLimit*> theListedLimits{nullptr};
+
+}
+
+bool LogRateLimit::admitPerSecond()
+{
+    const uint64_t interval = 1000000 / count;
+    const uint64_t tolerance = interval * (count - 1);
+    const uint64_t now = platformMicroseconds();
+
+    uint64_t arrival = state.load(std::memory_order_relaxed);
+    do
+    {
+        const uint64_t start = (arrival > now) ? arrival : now;
+        if(start - now > tolerance)
+        {
+            repeats.fetchAdd(1, std::memory_order_relaxed);
+            if( ! isListed.load(std::memory_order_relaxed) && ! isListed.exchange(true, std::memory_order_relaxed) )
+            {
+                next = theListedLimits.load(std::memory_order_relaxed);
+                while( ! theListedLimits.compareExchangeWeak(next, this, std::memory_order_release, std::memory_order_relaxed) )
+                {}
+            }
+            return false;
+        }
+        if(state.compareExchangeWeak(arrival, start + interval, std::memory_order_relaxed))
+        {
+            break;
+        }
+    } while(true);
+
+    const uint32_t suppressed = repeats.exchange(0, std::memory_order_relaxed);
+    if(suppressed)
+    {
+        report(suppressed);
+    }
+    return true;
+}
+
+void LogRateLimit::report(uint32_t suppressed)
+{
+    LogEntry le(line, file);
+    le.format("Repeated %u times", static_cast<unsigned int>(suppressed));
+    le.setType(type);
+    LoggingSystem::instance()->sinkEntry(le);
+}
+
+void LogRateLimit::reportRepeats()
+{
+    for(LogRateLimit *limit = theListedLimits.load(std::memory_order_acquire); limit; limit = limit->next)
+    {
+        const uint32_t suppressed = limit->repeats.exchange(0, std::memory_order_relaxed);
+        if(suppressed)
+        {
+            limit->report(suppressed);
+        }
+    }
+}
+
+}
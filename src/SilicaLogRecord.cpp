@@ -0,0 +1,62 @@
+#include <silica/LogRecord.h>
+#include <silica/LogFields.h>
+#include <stdio.h>
+
+namespace Silica
+{
+
+LogRecord::LogRecord(const LogEntry &entry)
+    : d{entry, false, 0, {}}
+{}
+
+const char *LogRecord::text() const
+{
+    if( ! d.isFormatted )
+    {
+        format();
+    }
+    return d.text;
+}
+
+size_t LogRecord::textLength() const
+{
+    if( ! d.isFormatted )
+    {
+        format();
+    }
+    return d.textLength;
+}
+
+char LogRecord::indicatorOf(LogEntry::Type type)
+{
+    switch(type)
+    {
+    case LogEntry::Type::Trace:     return 'T';
+    case LogEntry::Type::Debug:     return 'D';
+    case LogEntry::Type::Log:       return 'L';
+    case LogEntry::Type::Warning:   return 'W';
+    case LogEntry::Type::Fatal:     return 'F';
+    }
+    return '?';
+}
+
+void LogRecord::format() const
+{
+    const bool hasFields = d.entry.fieldsSize() != 0;
+    const char *separator = (hasFields && d.entry.message()[0]) ? " " : "";
+    const int length = snprintf(d.text, sizeof(d.text) - 1, "# %c : %4zu : %-*.*s : %s%s",
+                                indicatorOf(d.entry.type()), d.entry.originatingLine(),
+                                SILICA_LOGENTRY_FILENAME_MAX_LENGTH, SILICA_LOGENTRY_FILENAME_MAX_LENGTH, d.entry.originatingFile(),
+                                d.entry.message(), separator);
+    size_t textLength = (length < 0) ? 0 : ( static_cast<size_t>(length) < sizeof(d.text) - 1 ? static_cast<size_t>(length) : sizeof(d.text) - 2 );
+    if(hasFields)
+    {
+        textLength += LogFields::appendText(d.entry, d.text + textLength, sizeof(d.text) - 1 - textLength);
+    }
+    d.text[textLength++] = '\n';
+    d.text[textLength] = 0;
+    d.textLength = textLength;
+    d.isFormatted = true;
+}
+
+}
@@ -1,16 +1,52 @@
 #include "include/silica/LoggingSystem.h"
+#include "include/silica/LogRateLimit.h"
 #include <new>
 #include <cstddef>
 #include <stdio.h>
+#include <string.h>
 
 void registerDefaultLogSink(Silica::LoggingSystem *);
 
 alignas(Silica::LoggingSystem) char theInstanceData[sizeof(Silica::LoggingSystem)] = {};
-Silica::LoggingSystem * theInstance = nullptr;
+Silica::Atomic<Silica::LoggingSystem*> theInstance{nullptr};
+Silica::Atomic<bool> isInstanceConstructed{false};
 
 namespace Silica
 {
 
+namespace
+{
+
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+thread_local bool isDelivering = false;
+#endif
+
+const char *baseNameOf(const char *path)
+{
+    const char *baseName = path;
+    for(const char *c = path; *c; c++)
+    {
+        if( (*c == '/') || (*c == '\\') )
+        {
+            baseName = c + 1;
+        }
+    }
+    return baseName;
+}
+
+}
+
+Atomic<uint32_t> LogLevelFilter::currentGeneration{1};
+
+bool LogLevelFilter::refresh(uint32_t generation)
+{
+    const bool isEnabled = (type == LogEntry::Type::Fatal)
+                           || (type >= LoggingSystem::instance()->level(file, category));
+    // Should the thresholds change meanwhile, the generation stored here is already outdated, and the next call looks again.
+    state.store( (generation << 1) | (isEnabled ? 1 : 0), std::memory_order_relaxed);
+    return isEnabled;
+}
+
 LoggingSystem::LoggingSystem()
 {}
 
@@ -19,24 +55,237 @@ LoggingSystem::~LoggingSystem()
 
 LoggingSystem* LoggingSystem::instance()
 {
-    if ( ! theInstance )
+    LoggingSystem *instance = theInstance.load(std::memory_order_acquire);
+    if(instance)
     {
-        theInstance = new (theInstanceData)LoggingSystem();
-        registerDefaultLogSink(theInstance);
+        return instance;
     }
-    return theInstance;
+    // The first thread constructs the instance, any other waits until it is ready.
+    if( ! isInstanceConstructed.exchange(true, std::memory_order_acquire) )
+    {
+        instance = new (theInstanceData)LoggingSystem();
+        registerDefaultLogSink(instance);
+        theInstance.store(instance, std::memory_order_release);
+        return instance;
+    }
+    while( ! (instance = theInstance.load(std::memory_order_acquire)) )
+    {}
+    return instance;
 }
 
 void LoggingSystem::setSink(LogSink *sink)
 {
-    d.sink = sink;
+    d.sinkCount = 0;
+    if(sink)
+    {
+        addSink(sink);
+    }
+}
+
+bool LoggingSystem::addSink(LogSink *sink)
+{
+    if(d.sinkCount == SILICA_LOGGING_MAX_SINKS)
+    {
+        return false;
+    }
+    for(size_t i = 0; i < d.sinkCount; i++)
+    {
+        if(d.sinks[i] == sink)
+        {
+            return false;
+        }
+    }
+    for(size_t i = d.sinkCount; i > 0; i--)
+    {
+        d.sinks[i] = d.sinks[i - 1];
+    }
+    d.sinks[0] = sink;
+    d.sinkCount++;
+    sink->d.pendingEntries = 0;
+    return true;
+}
+
+void LoggingSystem::removeSink(LogSink *sink)
+{
+    for(size_t i = 0; i < d.sinkCount; i++)
+    {
+        if(d.sinks[i] == sink)
+        {
+            sink->flush();
+            for(size_t j = i + 1; j < d.sinkCount; j++)
+            {
+                d.sinks[j - 1] = d.sinks[j];
+            }
+            d.sinkCount--;
+            return;
+        }
+    }
+}
+
+void LoggingSystem::deliver(const LogEntry &entry, bool isStaged)
+{
+    const LogRecord record(entry);
+    for(size_t i = 0; i < d.sinkCount; i++)
+    {
+        LogSink *sink = d.sinks[i];
+        if( (entry.type() < sink->d.level) || (isStaged && sink->d.isSynchronous) )
+        {
+            continue;
+        }
+        if(entry.type() == LogEntry::Type::Fatal)
+        {
+            flushSinks(); // The sink may terminate the program.
+        }
+        sink->sinkRecord(record);
+        sink->d.pendingEntries++;
+        if( sink->d.flushInterval && (sink->d.pendingEntries >= sink->d.flushInterval) )
+        {
+            sink->flush();
+            sink->d.pendingEntries = 0;
+        }
+    }
+}
+
+void LoggingSystem::endBatch()
+{
+    for(size_t i = 0; i < d.sinkCount; i++)
+    {
+        LogSink *sink = d.sinks[i];
+        if( (sink->d.flushInterval == 0) && sink->d.pendingEntries )
+        {
+            sink->flush();
+            sink->d.pendingEntries = 0;
+        }
+    }
+}
+
+void LoggingSystem::flushSinks()
+{
+    for(size_t i = 0; i < d.sinkCount; i++)
+    {
+        LogSink *sink = d.sinks[i];
+        if(sink->d.pendingEntries)
+        {
+            sink->flush();
+            sink->d.pendingEntries = 0;
+        }
+    }
 }
 
 void LoggingSystem::sinkEntry(const LogEntry &entry)
 {
-    if(d.sink)
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+    if(entry.type() == LogEntry::Type::Fatal)
+    {
+        waitForWriter();
+    }
+    else if(enqueue(entry))
+    {
+        return;
+    }
+#endif
+    const bool isLocked = lockDelivery();
+    deliver(entry);
+    endBatch();
+    if(isLocked)
+    {
+        unlockDelivery();
+    }
+}
+
+bool LoggingSystem::lockDelivery()
+{
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+    if(isDelivering)
+    {
+        return false;
+    }
+    d.deliveryMutex.lock();
+    isDelivering = true;
+    return true;
+#else
+    return false;
+#endif
+}
+
+void LoggingSystem::unlockDelivery()
+{
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+    isDelivering = false;
+    d.deliveryMutex.unlock();
+#endif
+}
+
+void LoggingSystem::setLevel(LogEntry::Type minimum)
+{
+    {
+        MutexLocker locker(d.levelMutex);
+        d.defaultLevel = minimum;
+    }
+    LogLevelFilter::currentGeneration.fetchAdd(1, std::memory_order_release);
+}
+
+bool LoggingSystem::setLevel(const char *name, LogEntry::Type minimum)
+{
+    {
+        MutexLocker locker(d.levelMutex);
+        size_t index = 0;
+        while( (index < d.levelRuleCount) && (strcmp(d.levelRules[index].name, name) != 0) )
+        {
+            index++;
+        }
+        if(index == SILICA_LOG_LEVEL_RULES)
+        {
+            return false;
+        }
+        if(index == d.levelRuleCount)
+        {
+            d.levelRuleCount++;
+        }
+        d.levelRules[index].name = name;
+        d.levelRules[index].minimum = minimum;
+    }
+    LogLevelFilter::currentGeneration.fetchAdd(1, std::memory_order_release);
+    return true;
+}
+
+void LoggingSystem::clearLevels()
+{
+    {
+        MutexLocker locker(d.levelMutex);
+        d.levelRuleCount = 0;
+    }
+    LogLevelFilter::currentGeneration.fetchAdd(1, std::memory_order_release);
+}
+
+LogEntry::Type LoggingSystem::level(const char *file, const char *category)
+{
+    const char *name = category ? category : baseNameOf(file);
+    MutexLocker locker(d.levelMutex);
+    for(size_t i = 0; i < d.levelRuleCount; i++)
+    {
+        if(strcmp(d.levelRules[i].name, name) == 0)
+        {
+            return d.levelRules[i].minimum;
+        }
+    }
+    return d.defaultLevel;
+}
+
+void LoggingSystem::flush()
+{
+    LogRateLimit::reportRepeats();
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+    if(waitForWriter())
+    {
+        return;
+    }
+#endif
+    const bool isLocked = lockDelivery();
+    flushSinks();
+    if(isLocked)
     {
-        d.sink->sinkEntry(entry);
+        unlockDelivery();
     }
 }
 
@@ -1,7 +1,227 @@
 #include <silica/Mutex.h>
+#include <silica/Atomic.h>
+#include <silica/LogFields.h>
 
 namespace Silica
 {
+
+#ifdef SILICA_ENABLE_MUTEX_STATISTICS
+namespace
+{
+
+/*
+ * The registry of all Mutexes is guarded by a spin lock, as a Mutex cannot
+ * guard the list it registers itself in. It is only taken when a Mutex is
+ * constructed or destroyed, and by mostContended().
+ */
+Atomic<bool> isRegistryLocked{false};
+Mutex *firstMutex = nullptr;
+
+void lockRegistry()
+{
+    while(isRegistryLocked.exchange(true, std::memory_order_acquire))
+    {
+        cpuRelax();
+    }
+}
+
+void unlockRegistry()
+{
+    isRegistryLocked.store(false, std::memory_order_release);
+}
+
+void add(Atomic<uint64_t> &counter, uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+}
+#endif
+
+Mutex::Mutex(const char *name)
+{
+#ifdef SILICA_ENABLE_MUTEX_STATISTICS
+    d.name = name;
+    lockRegistry();
+    d.next = firstMutex;
+    if(firstMutex)
+    {
+        firstMutex->d.previous = this;
+    }
+    firstMutex = this;
+    unlockRegistry();
+#else
+    (void)name;
+#endif
+}
+
+Mutex::~Mutex()
+{
+#ifdef SILICA_ENABLE_MUTEX_STATISTICS
+    lockRegistry();
+    if(d.previous)
+    {
+        d.previous->d.next = d.next;
+    }
+    else
+    {
+        firstMutex = d.next;
+    }
+    if(d.next)
+    {
+        d.next->d.previous = d.previous;
+    }
+    unlockRegistry();
+#endif
+}
+
+void Mutex::lock()
+{
+    int32_t unlocked = 0;
+    if( ! d.state.compareExchange(unlocked, 1, std::memory_order_acquire, std::memory_order_relaxed) )
+    {
+        lockContended();
+    }
+#ifdef SILICA_ENABLE_MUTEX_STATISTICS
+    add(d.acquisitions, 1);
+#endif
+}
+
+void Mutex::lockContended()
+{
+#ifdef SILICA_ENABLE_MUTEX_STATISTICS
+    const uint64_t waitStart = platformNanoseconds();
+#endif
+    bool isLocked = false;
+    for(int i = 0; (i < SILICA_MUTEX_SPIN_COUNT) && ! isLocked; i++)
+    {
+        int32_t state = d.state.load(std::memory_order_relaxed);
+        if(state == 0)
+        {
+            isLocked = d.state.compareExchangeWeak(state, 1, std::memory_order_acquire, std::memory_order_relaxed);
+        }
+        else if(state == 2)
+        {
+            break; // Others are parked already, spinning would only overtake them
+        }
+        else
+        {
+            cpuRelax();
+        }
+    }
+    if( ! isLocked )
+    {
+        // Marking the Mutex with 2 makes unlock() wake a parked thread. Locking it with the mark kept costs a spurious wake at most.
+        while(d.state.exchange(2, std::memory_order_acquire) != 0)
+        {
+            platformWait(2);
+        }
+    }
+#ifdef SILICA_ENABLE_MUTEX_STATISTICS
+    const uint64_t waited = platformNanoseconds() - waitStart;
+    add(d.contendedAcquisitions, 1);
+    add(d.totalWaitNanoseconds, waited);
+    if(waited > d.maxWaitNanoseconds.load(std::memory_order_relaxed))
+    {
+        d.maxWaitNanoseconds.store(waited, std::memory_order_relaxed);
+    }
+#endif
+}
+
+void Mutex::unlock()
+{
+    if(d.state.exchange(0, std::memory_order_release) == 2)
+    {
+        platformWake();
+    }
+}
+
+bool Mutex::tryLock()
+{
+    int32_t unlocked = 0;
+    if( ! d.state.compareExchange(unlocked, 1, std::memory_order_acquire, std::memory_order_relaxed) )
+    {
+        return false;
+    }
+#ifdef SILICA_ENABLE_MUTEX_STATISTICS
+    add(d.acquisitions, 1);
+#endif
+    return true;
+}
+
+MutexStatistics Mutex::statistics() const
+{
+    MutexStatistics statistics;
+#ifdef SILICA_ENABLE_MUTEX_STATISTICS
+    statistics.name = d.name;
+    statistics.acquisitions = d.acquisitions.load(std::memory_order_relaxed);
+    statistics.contendedAcquisitions = d.contendedAcquisitions.load(std::memory_order_relaxed);
+    statistics.totalWaitNanoseconds = d.totalWaitNanoseconds.load(std::memory_order_relaxed);
+    statistics.maxWaitNanoseconds = d.maxWaitNanoseconds.load(std::memory_order_relaxed);
+#endif
+    return statistics;
+}
+
+void Mutex::resetStatistics()
+{
+#ifdef SILICA_ENABLE_MUTEX_STATISTICS
+    d.acquisitions.store(0, std::memory_order_relaxed);
+    d.contendedAcquisitions.store(0, std::memory_order_relaxed);
+    d.totalWaitNanoseconds.store(0, std::memory_order_relaxed);
+    d.maxWaitNanoseconds.store(0, std::memory_order_relaxed);
+#endif
+}
+
+size_t Mutex::mostContended(MutexStatistics *statistics, size_t capacity)
+{
+    size_t count = 0;
+#ifdef SILICA_ENABLE_MUTEX_STATISTICS
+    lockRegistry();
+    for(const Mutex *mutex = firstMutex; mutex; mutex = mutex->d.next)
+    {
+        const MutexStatistics candidate = mutex->statistics();
+        if(candidate.contendedAcquisitions == 0)
+        {
+            continue;
+        }
+        // Insertion into the sorted top list, the last one falls out once it is full
+        size_t position = count;
+        while( (position > 0) && (statistics[position - 1].totalWaitNanoseconds < candidate.totalWaitNanoseconds) )
+        {
+            if(position < capacity)
+            {
+                statistics[position] = statistics[position - 1];
+            }
+            position--;
+        }
+        if(position < capacity)
+        {
+            statistics[position] = candidate;
+            if(count < capacity)
+            {
+                count++;
+            }
+        }
+    }
+    unlockRegistry();
+#else
+    (void)statistics;
+    (void)capacity;
+#endif
+    return count;
+}
+
+void Mutex::logMostContended(size_t count)
+{
+    MutexStatistics top[16];
+    const size_t found = mostContended(top, (count < 16) ? count : 16);
+    for(size_t i = 0; i < found; i++)
+    {
+        LOG_KV("mutex", top[i].name ? top[i].name : "?", "acq", top[i].acquisitions, "cont", top[i].contendedAcquisitions,
+               "wait_ns", top[i].totalWaitNanoseconds, "max_ns", top[i].maxWaitNanoseconds);
+    }
+}
+
 MutexLocker::MutexLocker(Mutex &target)
     : target(target)
 {
@@ -0,0 +1,130 @@
+#include <silica/ReadWriteLock.h>
+#include <silica/Atomic.h>
+
+namespace Silica
+{
+
+ReadWriteLock::ReadWriteLock()
+{}
+
+ReadWriteLock::~ReadWriteLock()
+{}
+
+bool ReadWriteLock::tryLockForRead()
+{
+    int32_t state = d.state.load(std::memory_order_relaxed);
+    while( (state & (writerBit | writerWaitingBit)) == 0 )
+    {
+        if(d.state.compareExchangeWeak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ReadWriteLock::lockForRead()
+{
+    for(int i = 0; i < SILICA_READ_WRITE_LOCK_SPIN_COUNT; i++)
+    {
+        if(tryLockForRead())
+        {
+            return;
+        }
+        cpuRelax();
+    }
+
+    d.waiters.fetchAdd(1, std::memory_order_seq_cst);
+    int32_t state = d.state.load(std::memory_order_seq_cst);
+    for(;;)
+    {
+        if( (state & (writerBit | writerWaitingBit)) == 0 )
+        {
+            if(d.state.compareExchangeWeak(state, state + 1, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                break;
+            }
+            continue;
+        }
+        platformWait(state);
+        state = d.state.load(std::memory_order_seq_cst);
+    }
+    d.waiters.fetchSub(1, std::memory_order_relaxed);
+}
+
+void ReadWriteLock::unlockForRead()
+{
+    const int32_t previous = d.state.fetchSub(1, std::memory_order_seq_cst);
+    if((previous & readersMask) == 1)
+    {
+        wakeWaiters();
+    }
+}
+
+bool ReadWriteLock::tryLockForWrite()
+{
+    int32_t state = d.state.load(std::memory_order_relaxed);
+    while( (state & ~writerWaitingBit) == 0 )
+    {
+        if(d.state.compareExchangeWeak(state, writerBit, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ReadWriteLock::lockForWrite()
+{
+    for(int i = 0; i < SILICA_READ_WRITE_LOCK_SPIN_COUNT; i++)
+    {
+        if(tryLockForWrite())
+        {
+            return;
+        }
+        cpuRelax();
+    }
+
+    d.waiters.fetchAdd(1, std::memory_order_seq_cst);
+    int32_t state = d.state.load(std::memory_order_seq_cst);
+    for(;;)
+    {
+        if( (state & ~writerWaitingBit) == 0 )
+        {
+            // Taking the lock clears the waiting bit, other waiting writers set it again once they are woken
+            if(d.state.compareExchangeWeak(state, writerBit, std::memory_order_acquire, std::memory_order_relaxed))
+            {
+                break;
+            }
+            continue;
+        }
+        if( (state & writerWaitingBit) == 0 )
+        {
+            // Holds back new readers
+            if( ! d.state.compareExchangeWeak(state, state | writerWaitingBit, std::memory_order_relaxed, std::memory_order_relaxed) )
+            {
+                continue;
+            }
+            state |= writerWaitingBit;
+        }
+        platformWait(state);
+        state = d.state.load(std::memory_order_seq_cst);
+    }
+    d.waiters.fetchSub(1, std::memory_order_relaxed);
+}
+
+void ReadWriteLock::unlockForWrite()
+{
+    d.state.fetchAnd(~writerBit, std::memory_order_seq_cst);
+    wakeWaiters();
+}
+
+void ReadWriteLock::wakeWaiters()
+{
+    if(d.waiters.load(std::memory_order_seq_cst) > 0)
+    {
+        platformWakeAll();
+    }
+}
+
+}
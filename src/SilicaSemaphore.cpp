@@ -0,0 +1,108 @@
+#include <silica/Semaphore.h>
+#include <silica/Atomic.h>
+
+namespace Silica
+{
+
+Semaphore::Semaphore(int32_t initialCount)
+{
+    d.count.store(initialCount);
+    d.waiters.store(0);
+}
+
+Semaphore::~Semaphore()
+{}
+
+bool Semaphore::tryAcquire()
+{
+    int32_t current = d.count.load(std::memory_order_relaxed);
+    while(current > 0)
+    {
+        if(d.count.compareExchangeWeak(current, current - 1, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t Semaphore::tryAcquireUpTo(size_t maximum)
+{
+    int32_t current = d.count.load(std::memory_order_relaxed);
+    while(current > 0)
+    {
+        const int32_t taken = (size_t(current) < maximum) ? current : int32_t(maximum);
+        if(d.count.compareExchangeWeak(current, current - taken, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            return taken;
+        }
+    }
+    return 0;
+}
+
+bool Semaphore::spin()
+{
+    for(int i = 0; i < SILICA_SEMAPHORE_SPIN_COUNT; i++)
+    {
+        if(tryAcquire())
+        {
+            return true;
+        }
+        cpuRelax();
+    }
+    return false;
+}
+
+void Semaphore::acquire()
+{
+    acquireWithTimeout(-1);
+}
+
+bool Semaphore::tryAcquireFor(MicroSeconds timeout)
+{
+    return acquireWithTimeout(static_cast<int64_t>(uint64_t(timeout)));
+}
+
+bool Semaphore::acquireWithTimeout(int64_t timeoutMicroseconds)
+{
+    if(spin())
+    {
+        return true;
+    }
+
+    const int64_t deadline = platformMicroseconds() + timeoutMicroseconds;
+    d.waiters.fetchAdd(1, std::memory_order_seq_cst);
+    bool acquired = false;
+    while( ! (acquired = tryAcquire()) )
+    {
+        int64_t remaining = -1;
+        if(timeoutMicroseconds >= 0)
+        {
+            remaining = deadline - platformMicroseconds();
+            if(remaining <= 0)
+            {
+                break;
+            }
+        }
+        platformWait(0, remaining);
+    }
+    d.waiters.fetchSub(1, std::memory_order_relaxed);
+    return acquired;
+}
+
+void Semaphore::release(int32_t count)
+{
+    d.count.fetchAdd(count, std::memory_order_seq_cst);
+    const int32_t waiting = d.waiters.load(std::memory_order_seq_cst);
+    if(waiting > 0)
+    {
+        platformWake(count < waiting ? count : waiting);
+    }
+}
+
+int32_t Semaphore::available() const
+{
+    return d.count.load(std::memory_order_relaxed);
+}
+
+}
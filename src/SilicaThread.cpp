@@ -0,0 +1,66 @@
+#include <silica/Thread.h>
+#include <string.h>
+
+namespace Silica
+{
+
+Thread::Thread()
+{}
+
+Thread::~Thread()
+{
+    join();
+}
+
+void Thread::setName(const char *name)
+{
+    strncpy(d.name, name ? name : "", nameMaxLength);
+    d.name[nameMaxLength] = 0;
+}
+
+bool Thread::start(Task entry)
+{
+    if(d.isStarted)
+    {
+        return false;
+    }
+    d.entry = std::move(entry);
+    d.isConfigured = false;
+    if( ! platformStart() )
+    {
+        d.entry.reset();
+        return false;
+    }
+    d.configured.acquire();
+    d.isStarted = true;
+    if( ! d.isConfigured )
+    {
+        join();
+        d.entry.reset();
+        return false;
+    }
+    return true;
+}
+
+void Thread::join()
+{
+    if(d.isStarted)
+    {
+        platformJoin();
+        d.isStarted = false;
+    }
+}
+
+void Thread::run(Thread *thread)
+{
+    const bool isConfigured = thread->platformConfigureCurrentThread();
+    thread->d.isConfigured = isConfigured;
+    thread->d.configured.release();
+    if(isConfigured)
+    {
+        thread->d.entry();
+        thread->d.entry.reset();
+    }
+}
+
+}
@@ -0,0 +1,141 @@
+#include <silica/ThreadPool.h>
+#include <silica/Application.h>
+#include <silica/LoggingSystem.h>
+
+namespace Silica
+{
+
+// The pool and worker the calling thread belongs to, if any.
+static thread_local ThreadPool *currentPool = nullptr;
+static thread_local void *currentWorker = nullptr;
+
+ThreadPool::ThreadPool(size_t workerCount)
+{
+    if(workerCount == 0)
+    {
+        workerCount = std::thread::hardware_concurrency();
+        if(workerCount == 0)
+        {
+            workerCount = 1;
+        }
+    }
+
+    Application *application = Application::instance();
+    if(application->d.threadPool)
+    {
+        FATAL("Only a single ThreadPool may be attached to the Application.");
+    }
+
+    for(size_t i = 0; i < workerCount; i++)
+    {
+        Worker *worker = new Worker();
+        worker->index = i;
+        d.workers.append(worker);
+    }
+    for(Worker *worker : d.workers)
+    {
+        worker->thread = std::thread(&ThreadPool::run, this, worker);
+    }
+    application->d.threadPool = this;
+}
+
+ThreadPool::~ThreadPool()
+{
+    d.stopping.store(true);
+    d.pendingTasks.release(int32_t(d.workers.size()));
+    for(Worker *worker : d.workers)
+    {
+        worker->thread.join();
+    }
+
+    // Detach only now, so tasks still draining may post subtasks through the Application.
+    if(Application::theApplicationInstance && (Application::theApplicationInstance->d.threadPool == this))
+    {
+        Application::theApplicationInstance->d.threadPool = nullptr;
+    }
+    for(Worker *worker : d.workers)
+    {
+        delete worker;
+    }
+}
+
+bool ThreadPool::post(Task task)
+{
+    if(d.stopping.load(std::memory_order_relaxed) && (currentPool != this))
+    {
+        return false;
+    }
+
+    Worker *target;
+    if(currentPool == this)
+    {
+        target = static_cast<Worker*>(currentWorker);
+    }
+    else
+    {
+        target = d.workers[d.nextWorker.fetch_add(1, std::memory_order_relaxed) % d.workers.size()];
+    }
+
+    {
+        MutexLocker locker(target->mutex);
+        target->tasks.pushBack(std::move(task));
+    }
+    d.pendingTasks.release(1);
+    return true;
+}
+
+bool ThreadPool::takeTask(Worker *self, Task &destination)
+{
+    {
+        MutexLocker locker(self->mutex);
+        if(self->tasks.popBack(destination))
+        {
+            return true;
+        }
+    }
+
+    const size_t count = d.workers.size();
+    for(size_t i = 1; i < count; i++)
+    {
+        Worker *victim = d.workers[(self->index + i) % count];
+        MutexLocker locker(victim->mutex);
+        if(victim->tasks.popFront(destination))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::run(Worker *self)
+{
+    currentPool = this;
+    currentWorker = self;
+
+    Task task;
+    while(true)
+    {
+        // Every queued Task has a token, so holding a token means a Task is waiting in some deque, unless we are stopping.
+        // A token must never be dropped without running a Task or exiting, or a Task is left without a worker to run it
+        // and the destructor waits forever. So keep scanning until the Task is found, even if another worker got to its
+        // deque first and this one has to find the one left behind by that worker's token.
+        d.pendingTasks.acquire();
+        bool hasTask = takeTask(self, task);
+        while( ! hasTask && ! d.stopping.load() )
+        {
+            std::this_thread::yield();
+            hasTask = takeTask(self, task);
+        }
+        if( ! hasTask )
+        {
+            break; // The token was one of those released by the destructor, one per worker.
+        }
+        task();
+        task.reset();
+    }
+
+    currentPool = nullptr;
+    currentWorker = nullptr;
+}
+
+}
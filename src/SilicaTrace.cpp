@@ -0,0 +1,200 @@
+#include <silica/Trace.h>
+#include <silica/Application.h>
+#include <silica/Mutex.h>
+#include <silica/RingBuffer.h>
+#include <inttypes.h>
+#include <stdint.h>
+
+namespace Silica
+{
+
+namespace
+{
+
+struct TraceEvent
+{
+    const char *name = nullptr;
+    const void *object = nullptr;
+    uint64_t timestamp = 0;
+    char phase = 0;
+};
+
+/*
+ * One buffer per thread, written only by that thread. Buffers are kept in a
+ * list that is only locked to add a thread, and are reused by new threads
+ * once their thread has exited and their events have been written. A full
+ * buffer drops new events rather than overwriting the oldest ones, so the
+ * recording thread only ever moves the tail and start() and
+ * writeChromeTrace() may pop the head while it records.
+ */
+struct ThreadTraceBuffer
+{
+    RingBuffer<TraceEvent, SILICA_TRACE_EVENTS_PER_THREAD> events;
+    unsigned threadIndex = 0;
+    bool isInUse = true;
+    ThreadTraceBuffer *next = nullptr;
+};
+
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+Mutex &bufferListMutex()
+{
+    static Mutex mutex("Trace::bufferListMutex");
+    return mutex;
+}
+#endif
+
+ThreadTraceBuffer *firstBuffer = nullptr;
+unsigned bufferCount = 0;
+
+ThreadTraceBuffer *acquireBuffer()
+{
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+    MutexLocker locker(bufferListMutex());
+#endif
+    for(ThreadTraceBuffer *buffer = firstBuffer; buffer; buffer = buffer->next)
+    {
+        if( ! buffer->isInUse && (buffer->events.size() == 0) )
+        {
+            buffer->isInUse = true;
+            return buffer;
+        }
+    }
+    ThreadTraceBuffer *buffer = new ThreadTraceBuffer();
+    buffer->events.setOverflowPolicy(OverflowPolicy::SkipNewData);
+    buffer->threadIndex = bufferCount++;
+    buffer->next = firstBuffer;
+    firstBuffer = buffer;
+    return buffer;
+}
+
+struct ThreadTraceBufferHolder
+{
+    ThreadTraceBuffer *buffer = nullptr;
+
+    ~ThreadTraceBufferHolder()
+    {
+        if(buffer)
+        {
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+            MutexLocker locker(bufferListMutex());
+#endif
+            buffer->isInUse = false; // Its events are kept until written.
+        }
+    }
+};
+
+thread_local ThreadTraceBufferHolder currentBuffer;
+
+void writeEscaped(FILE *file, const char *text)
+{
+    for(const char *c = text; *c; c++)
+    {
+        if( (*c == '"') || (*c == '\\') )
+        {
+            fputc('\\', file);
+        }
+        fputc(*c, file);
+    }
+}
+
+}
+
+Atomic<bool> Trace::enabled{false};
+
+void Trace::start()
+{
+    {
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+        MutexLocker locker(bufferListMutex());
+#endif
+        for(ThreadTraceBuffer *buffer = firstBuffer; buffer; buffer = buffer->next)
+        {
+            while(buffer->events.pop()) {}
+        }
+    }
+    enabled.store(true, std::memory_order_relaxed);
+}
+
+void Trace::stop()
+{
+    enabled.store(false, std::memory_order_relaxed);
+}
+
+void Trace::begin(const char *name, const void *object)
+{
+    record('B', name, object);
+}
+
+void Trace::end(const char *name, const void *object)
+{
+    record('E', name, object);
+}
+
+void Trace::instant(const char *name, const void *object)
+{
+    record('i', name, object);
+}
+
+void Trace::record(char phase, const char *name, const void *object)
+{
+    if( ! isEnabled() || ! Application::hasInstance() )
+    {
+        return;
+    }
+    if( ! currentBuffer.buffer )
+    {
+        currentBuffer.buffer = acquireBuffer();
+    }
+    TraceEvent event;
+    event.name = name;
+    event.object = object;
+    event.timestamp = Application::instance()->microsecondsSinceStart();
+    event.phase = phase;
+    currentBuffer.buffer->events.push(event);
+}
+
+size_t Trace::writeChromeTrace(FILE *file)
+{
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+    MutexLocker locker(bufferListMutex());
+#endif
+    size_t written = 0;
+    fputs("{\"traceEvents\":[", file);
+    for(ThreadTraceBuffer *buffer = firstBuffer; buffer; buffer = buffer->next)
+    {
+        while(buffer->events.size() > 0)
+        {
+            const TraceEvent event = buffer->events.peek();
+            buffer->events.pop();
+
+            fputs(written ? ",\n{\"name\":\"" : "\n{\"name\":\"", file);
+            writeEscaped(file, event.name);
+            fprintf(file, "\",\"cat\":\"silica\",\"ph\":\"%c\",\"ts\":%" PRIu64 ",\"pid\":1,\"tid\":%u", event.phase, event.timestamp, buffer->threadIndex);
+            if(event.phase == 'i')
+            {
+                fputs(",\"s\":\"t\"", file);
+            }
+            if(event.object)
+            {
+                fprintf(file, ",\"args\":{\"object\":\"%p\"}", event.object);
+            }
+            fputc('}', file);
+            written++;
+        }
+    }
+    fputs("\n],\"displayTimeUnit\":\"ms\"}\n", file);
+    return written;
+}
+
+bool Trace::writeChromeTrace(const char *path)
+{
+    FILE *file = fopen(path, "w");
+    if( ! file )
+    {
+        return false;
+    }
+    writeChromeTrace(file);
+    return fclose(file) == 0;
+}
+
+}
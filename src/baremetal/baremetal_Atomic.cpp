@@ -0,0 +1,34 @@
+#include <silica/Atomic.h>
+
+#ifdef SILICA_ATOMIC_MASK_INTERRUPTS
+
+namespace Silica
+{
+
+#if defined(__arm__)
+
+/*
+ * PRIMASK masks all interrupts with configurable priority. Its old value is
+ * kept, so that masking inside an interrupt handler or a masked section does
+ * not unmask on restore.
+ */
+
+uint32_t InterruptMask::platformMask()
+{
+    uint32_t previous;
+    __asm__ __volatile__("mrs %0, primask\n\tcpsid i" : "=r"(previous) :: "memory");
+    return previous;
+}
+
+void InterruptMask::platformRestore(uint32_t previous)
+{
+    __asm__ __volatile__("msr primask, %0" :: "r"(previous) : "memory");
+}
+
+#else
+    #error "SILICA_ATOMIC_MASK_INTERRUPTS requires InterruptMask::platformMask() and platformRestore() for this CPU."
+#endif
+
+}
+
+#endif
@@ -0,0 +1,31 @@
+#include <silica/Mutex.h>
+#include <silica/Application.h>
+
+namespace Silica
+{
+
+/*
+ * There are no other threads to yield to, so waiting is done by returning
+ * right away and letting lock() poll the state again. A Mutex is unlocked
+ * from interrupt handlers, which need no waking.
+ */
+
+void Mutex::platformWait(int32_t)
+{
+}
+
+void Mutex::platformWake()
+{
+}
+
+uint64_t Mutex::platformNanoseconds()
+{
+    // The clock is provided by the Application. Waits outside of its lifetime are counted as taking no time.
+    if( ! Application::hasInstance() )
+    {
+        return 0;
+    }
+    return uint64_t(Application::instance()->microsecondsSinceStart()) * 1000u;
+}
+
+}
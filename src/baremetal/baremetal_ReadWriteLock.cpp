@@ -0,0 +1,19 @@
+#include <silica/ReadWriteLock.h>
+
+namespace Silica
+{
+
+/*
+ * There are no other threads to yield to, so waiting is done by returning
+ * right away and letting the caller poll the state again.
+ */
+
+void ReadWriteLock::platformWait(int32_t)
+{
+}
+
+void ReadWriteLock::platformWakeAll()
+{
+}
+
+}
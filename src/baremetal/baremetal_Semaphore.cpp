@@ -0,0 +1,33 @@
+#include <silica/Semaphore.h>
+#include <silica/Application.h>
+#include <silica/LoggingSystem.h>
+
+namespace Silica
+{
+
+/*
+ * There are no other threads to yield to, so waiting is done by returning
+ * right away and letting the caller poll the count again. Tokens are
+ * released from interrupt handlers, which need no waking.
+ */
+
+void Semaphore::platformWait(int32_t, int64_t)
+{
+}
+
+void Semaphore::platformWake(int32_t)
+{
+}
+
+int64_t Semaphore::platformMicroseconds()
+{
+    // Without an operating system, the only clock is the one the board provides through the Application.
+    if( ! Application::hasInstance() )
+    {
+        FATAL("Semaphore timeouts on baremetal targets are measured with Application::microsecondsSinceStart() and require an Application.");
+        return 0;
+    }
+    return int64_t(uint64_t(Application::instance()->microsecondsSinceStart()));
+}
+
+}
@@ -0,0 +1,10 @@
+set( SILICA_OS_ARCH_PREFIX baremetal)
+
+set( HERE src/${SILICA_OS_ARCH_PREFIX} )
+set( silica_sources
+    ${silica_sources}
+    ${HERE}/${SILICA_OS_ARCH_PREFIX}_Atomic.cpp
+    ${HERE}/${SILICA_OS_ARCH_PREFIX}_Mutex.cpp
+    ${HERE}/${SILICA_OS_ARCH_PREFIX}_ReadWriteLock.cpp
+    ${HERE}/${SILICA_OS_ARCH_PREFIX}_Semaphore.cpp
+)
@@ -3,12 +3,20 @@
 
 #include <stddef.h>
 #include <silica/Array.h>
+#include <silica/Atomic.h>
+#include <silica/LoopStatistics.h>
 #include <silica/Macros.h>
+#include <silica/Mutex.h>
+#include <silica/Semaphore.h>
+#include <silica/Task.h>
 #include <silica/UnitsOfTime.h>
 #include <silica/SignalSlot.h>
 
 #ifndef SILICA_EVENT_GENERATORS_HELD_BY_APPLICATION
-#define SILICA_EVENT_GENERATORS_HELD_BY_APPLICATION 50
+    /*! The maximum number of EventGenerators that may be registered in the Application at once. 0, the default, means unbounded.
+    EventGenerators are kept in an intrusive list, so the bound does not change the size of the Application, it only makes registering beyond it fail with a warning.
+    */
+    #define SILICA_EVENT_GENERATORS_HELD_BY_APPLICATION 0
 #endif
 
 namespace Silica
@@ -32,11 +40,18 @@ public:
 
     /** \brief Runs the eventloop that drives the application.
      *
-     *  Calling exec performs various setup tasks and then enters an infinite eventloop. To exit an eventloop do one of the following:
+     *  Calling exec performs various setup tasks and then enters an infinite eventloop. Each pass of the eventloop visits the
+     *  EventGenerators that have been woken since the previous pass, in the order they were woken. If no EventGenerator is ready,
+     *  the calling thread sleeps until one is woken, or until the earliest time passed to EventGenerator::wakeAt() is due.
+     *
+     *  To exit an eventloop do one of the following:
      *  - Call Application::quit(exitcode). This will exit the loop with the provided exit code, and continut execution after the exec() call.
      *  - Call the FATAL() macro. That will cause application execution to halt, and no statements after the exec() is executed. Exactely how, FATAL ensures this, is platform dependent.
      *  - Call Application::abort(exitcode). This causes a behaviour similar to calling the FATAL macro.
      *
+     *  exec() may be called again after it has returned. An exit requested before exec() is called, e.g. by code run before the
+     *  event loop is entered, makes exec() return right away.
+     *
      *  \returns The exitcode provided by Application::quit or Application::abort.
     */
     int exec();
@@ -46,27 +61,112 @@ public:
      */
     static Application * instance();
 
+    /** \brief Returns true if an Application has been instantiated and not destroyed yet. Unlike instance(), it never logs. */
+    static bool hasInstance() { return theApplicationInstance != nullptr; }
+
     /** Returns the numbers of microseconds that has passed since application start.
      *  \returns The numbers of microseconds that has passed since application start.
     \addtogroup PlatformRequiresImplementation.*/
     MicroSeconds microsecondsSinceStart() const;
 
+    /** Returns the number of EventGenerators currently registered in this Application.
+     *  \returns The number of EventGenerators currently registered in this Application.
+     */
+    size_t eventGeneratorCount() const { return d.registeredEventGeneratorCount; }
+
+    /** \brief Returns the duration of the passes of the event loop and the number of stalls.
+     *
+     *  Only measured when built with \ref SILICA_ENABLE_LOOP_INSTRUMENTATION. Otherwise, all values are 0. May be called from any
+     *  thread while the event loop is running, e.g. to expose the statistics over a control interface.
+     *  \see EventGenerator::visitStatistics()
+     */
+    LoopStatistics loopStatistics() const;
+
+    /** \brief Sets the statistics returned by loopStatistics() to 0. */
+    void resetLoopStatistics();
+
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+    /** \brief Queues \p task to run on the attached ThreadPool.
+     *  \returns True if the task was queued. False if no ThreadPool is attached or it is shutting down.
+     *  \see ThreadPool
+     */
+    bool post(Task task);
+
+    /** \brief Runs \p work on the attached ThreadPool and emits \p finished on the event loop thread when done.
+     *
+     *  If \p work returns a value, it is passed as the argument of \p finished, which must then be a Signal taking exactly that type.
+     *  Otherwise \p finished must be a Signal<>.
+     *
+     *  \param work The callable to run on a worker thread.
+     *  \param finished The Signal to emit on the event loop thread once \p work has returned. May be nullptr.
+     *  \returns The same as post().
+     */
+    template <typename F, typename ...Rs>
+    bool runAsync(F work, Signal<Rs...> *finished);
+#endif
+
+    /** \brief Queues \p task to run on the event loop thread during the next pass of the event loop.
+     *
+     *  invokeOnLoop() may be called from any thread, and wakes the event loop if it is sleeping. Tasks are run in the order they were queued.
+     *  \note On baremetal targets, invokeOnLoop() must not be called from an interrupt handler, as the queue is not locked there.
+     */
+    void invokeOnLoop(Task task);
+
     Slot<int> exit;
 
     /// \cond DEVELOPER_DOC
 private:
 
     friend class EventGenerator;
+    friend class ThreadPool;
     static Application* theApplicationInstance;
     void exitImplementation(int exitCode);
     void platformSpecificInitialization();
 
+    bool registerEventGenerator(class EventGenerator *eventGenerator);
+    void unregisterEventGenerator(class EventGenerator *eventGenerator);
+    void markReady(class EventGenerator *eventGenerator);
+    void forgetReady(class EventGenerator *eventGenerator);
+    void scheduleWakeAt(class EventGenerator *eventGenerator, MicroSeconds time);
+    void cancelWakeAt(class EventGenerator *eventGenerator);
+    void wakeDueEventGenerators();
+    void notifyLoop();
+    void waitForReadyEventGenerators();
+    void runQueuedTasks();
+    uint64_t instrumentationTimestamp() const;
+    void visit(class EventGenerator *eventGenerator);
+
     struct
     {
-        bool exitRequested = false;
+        Atomic<bool> exitRequested{false};
         int providedExitCode = 0;
-        Silica::Array<class EventGenerator *, SILICA_EVENT_GENERATORS_HELD_BY_APPLICATION> eventGenerators;
 
+        // Intrusive doubly linked list of all registered EventGenerators. Only touched by the loop thread.
+        class EventGenerator *firstRegisteredEventGenerator = nullptr;
+        size_t registeredEventGeneratorCount = 0;
+
+        // Intrusive lock free list of woken EventGenerators, pushed to from any thread and taken by the loop.
+        Atomic<class EventGenerator *> readyHead{nullptr};
+        // The EventGenerators remaining to be visited in the current pass. Only touched by the loop thread.
+        class EventGenerator *passHead = nullptr;
+        // The EventGenerator being visited, cleared if it is unregistered from within its own visit().
+        class EventGenerator *visitedEventGenerator = nullptr;
+        [[no_unique_address]] LoopCounters loopCounters;
+
+        // Intrusive doubly linked list of EventGenerators waiting for wakeAt(), ordered by wake up time. Only touched by the loop thread.
+        class EventGenerator *firstTimedEventGenerator = nullptr;
+
+        Atomic<bool> loopSleeping{false};
+        Semaphore loopWakeups{0};
+
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+        class ThreadPool *threadPool = nullptr;
+        Mutex queuedTasksMutex{"Application::queuedTasksMutex"};
+#endif
+
+        // Tasks queued by invokeOnLoop(), run by the loop thread.
+        TaskDeque queuedTasks;
+        Atomic<size_t> queuedTaskCount{0};
     } d;
 
     /// \endcond
@@ -74,6 +174,36 @@ private:
 
 /// \cond DEVELOPER_DOC
 
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+template <typename F, typename ...Rs>
+bool Application::runAsync(F work, Signal<Rs...> *finished)
+{
+    static_assert(sizeof...(Rs) <= 1, "The finished Signal of runAsync() takes at most the single return value of the work.");
+    return post([this, work, finished]() mutable {
+        if constexpr (sizeof...(Rs) == 0)
+        {
+            work();
+            invokeOnLoop([finished](){
+                if(finished)
+                {
+                    emit (*finished)();
+                }
+            });
+        }
+        else
+        {
+            auto result = work();
+            invokeOnLoop([finished, result](){
+                if(finished)
+                {
+                    emit (*finished)(result);
+                }
+            });
+        }
+    });
+}
+#endif
+
 /// \endcond
 
 }
@@ -0,0 +1,302 @@
+#ifndef SILICA_ATOMIC_H
+#define SILICA_ATOMIC_H
+
+#include <stdint.h>
+#include <atomic>
+#include <type_traits>
+#include <silica/Macros.h>
+
+#if defined(_MSC_VER) && ( defined(_M_X64) || defined(_M_IX86) )
+    #include <intrin.h>
+#endif
+
+#if !defined(SILICA_ATOMIC_MASK_INTERRUPTS) && defined(__ARM_ARCH_6M__)
+    #define SILICA_ATOMIC_MASK_INTERRUPTS
+#endif
+
+#ifdef DOXYGEN
+    /*! Makes Silica::Atomic read-modify-write its value with interrupts masked, instead of with the atomic instructions of the CPU.
+
+    Defined by default for cores without such instructions, i.e. ARMv6-M like the Cortex-M0+, where <tt>std::atomic</tt> calls library
+    functions that baremetal toolchains do not provide. Masking interrupts only excludes the interrupt handlers of the same core, so
+    the shared state of a program defining it must not be touched by a second core. Requires \c InterruptMask::platformMask() and
+    \c InterruptMask::platformRestore().
+
+    All of Silica built for baremetal targets shares state through Atomic, including Mutex, Semaphore, ReadWriteLock, SeqLock,
+    Application and EventGenerator::wake(). Only the parts requiring an operating system, e.g. ThreadPool, Thread and asynchronous
+    logging, use <tt>std::atomic</tt> directly.
+    */
+#define SILICA_ATOMIC_MASK_INTERRUPTS
+#endif
+
+namespace Silica
+{
+
+/** \brief Tells the CPU that the calling thread spins, waiting for another thread or an interrupt handler.
+ *  It lets a sibling hyper-thread run, and saves power. It does not yield to the operating system. */
+inline void cpuRelax()
+{
+#if defined(_MSC_VER) && ( defined(_M_X64) || defined(_M_IX86) )
+    _mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield" ::: "memory");
+#endif
+}
+
+/** \brief Orders the memory accesses of the calling thread before and after it, as seen by other threads and cores. */
+inline void atomicFence(std::memory_order order = std::memory_order_seq_cst)
+{
+    std::atomic_thread_fence(order);
+}
+
+/** \brief Keeps the compiler from moving memory accesses across it, without emitting an instruction.
+ *  Enough to order accesses seen by an interrupt handler or signal handler running on the same core. */
+inline void signalFence(std::memory_order order = std::memory_order_seq_cst)
+{
+    std::atomic_signal_fence(order);
+}
+
+/// \cond DEVELOPER_DOC
+#ifdef SILICA_ATOMIC_MASK_INTERRUPTS
+/*
+ * Masks the interrupts of the calling core for its lifetime, restoring the
+ * mask that was set before, so that it nests.
+ */
+class InterruptMask
+{
+    DISABLE_COPY(InterruptMask);
+    DISABLE_MOVE(InterruptMask);
+
+public:
+    InterruptMask()
+        : previous(platformMask())
+    {
+        signalFence();
+    }
+
+    ~InterruptMask()
+    {
+        signalFence();
+        platformRestore(previous);
+    }
+
+private:
+    /** Masks the interrupts of the calling core, and returns the mask set before.
+        \addtogroup PlatformRequiresImplementation */
+    static uint32_t platformMask();
+
+    /** Sets the interrupt mask \p previous returned by platformMask().
+        \addtogroup PlatformRequiresImplementation */
+    static void platformRestore(uint32_t previous);
+
+    const uint32_t previous;
+};
+#endif
+/// \endcond
+
+/** \brief Atomic holds a value of type \c T that threads and interrupt handlers access without data races.
+
+On Linux and Windows, and on cores with atomic instructions, Atomic is a thin wrapper of <tt>std::atomic<T></tt>, and costs nothing
+on top of it. With \ref SILICA_ATOMIC_MASK_INTERRUPTS, e.g. on a Cortex-M0+, every access is done with the interrupts of the core
+masked, so that main code and interrupt handlers can share state on cores lacking atomic instructions.
+
+Use Atomic for all state shared between threads, or between main code and interrupt handlers, instead of \c volatile, which neither
+makes read-modify-write operations atomic nor orders accesses. Every operation takes a <tt>std::memory_order</tt>, which defaults to
+the strictest, <tt>std::memory_order_seq_cst</tt>. Relax it where the algorithm allows, and the weaker orders are cheaper on ARM.
+
+\c T must be trivially copyable. The arithmetic and bit operations require an integral \c T.
+
+\ingroup Core
+ */
+template<typename T>
+class Atomic
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Atomic requires a trivially copyable T");
+
+    DISABLE_COPY(Atomic);
+    DISABLE_MOVE(Atomic);
+
+public:
+    /** \brief Creates an Atomic holding \p initialValue. Constant initialized, so a static Atomic is ready before any code runs. */
+    constexpr Atomic(T initialValue = T()) noexcept
+        : value(initialValue)
+    {}
+
+    /** \brief Returns the value. */
+    T load(std::memory_order order = std::memory_order_seq_cst) const noexcept
+    {
+#ifdef SILICA_ATOMIC_MASK_INTERRUPTS
+        (void)order;
+        InterruptMask mask;
+        return value;
+#else
+        return value.load(order);
+#endif
+    }
+
+    /** \brief Replaces the value with \p newValue. */
+    void store(T newValue, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+#ifdef SILICA_ATOMIC_MASK_INTERRUPTS
+        (void)order;
+        InterruptMask mask;
+        value = newValue;
+#else
+        value.store(newValue, order);
+#endif
+    }
+
+    /** \brief Replaces the value with \p newValue. \returns The value before. */
+    T exchange(T newValue, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+#ifdef SILICA_ATOMIC_MASK_INTERRUPTS
+        (void)order;
+        InterruptMask mask;
+        const T previous = value;
+        value = newValue;
+        return previous;
+#else
+        return value.exchange(newValue, order);
+#endif
+    }
+
+    /** \brief Replaces the value with \p desired if it equals \p expected, otherwise loads it into \p expected.
+     *  \returns True if the value was replaced. */
+    bool compareExchange(T &expected, T desired, std::memory_order success, std::memory_order failure) noexcept
+    {
+#ifdef SILICA_ATOMIC_MASK_INTERRUPTS
+        (void)success;
+        (void)failure;
+        InterruptMask mask;
+        if(value == expected)
+        {
+            value = desired;
+            return true;
+        }
+        expected = value;
+        return false;
+#else
+        return value.compare_exchange_strong(expected, desired, success, failure);
+#endif
+    }
+
+    /** \brief Like compareExchange(), using \p order on success, and the strongest order valid for a load on failure. */
+    bool compareExchange(T &expected, T desired, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return compareExchange(expected, desired, order, failureOrderOf(order));
+    }
+
+    /** \brief Like compareExchange(), but may fail spuriously, which is cheaper on some CPUs. Meant to be called in a loop. */
+    bool compareExchangeWeak(T &expected, T desired, std::memory_order success, std::memory_order failure) noexcept
+    {
+#ifdef SILICA_ATOMIC_MASK_INTERRUPTS
+        return compareExchange(expected, desired, success, failure);
+#else
+        return value.compare_exchange_weak(expected, desired, success, failure);
+#endif
+    }
+
+    /** \brief Like compareExchangeWeak(), using \p order on success, and the strongest order valid for a load on failure. */
+    bool compareExchangeWeak(T &expected, T desired, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        return compareExchangeWeak(expected, desired, order, failureOrderOf(order));
+    }
+
+    /** \brief Adds \p operand to the value. \returns The value before. */
+    T fetchAdd(T operand, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        static_assert(std::is_integral_v<T>, "fetchAdd() requires an integral T");
+#ifdef SILICA_ATOMIC_MASK_INTERRUPTS
+        (void)order;
+        InterruptMask mask;
+        const T previous = value;
+        value = previous + operand;
+        return previous;
+#else
+        return value.fetch_add(operand, order);
+#endif
+    }
+
+    /** \brief Subtracts \p operand from the value. \returns The value before. */
+    T fetchSub(T operand, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        static_assert(std::is_integral_v<T>, "fetchSub() requires an integral T");
+#ifdef SILICA_ATOMIC_MASK_INTERRUPTS
+        (void)order;
+        InterruptMask mask;
+        const T previous = value;
+        value = previous - operand;
+        return previous;
+#else
+        return value.fetch_sub(operand, order);
+#endif
+    }
+
+    /** \brief Sets the value to the bitwise and of it and \p operand. \returns The value before. */
+    T fetchAnd(T operand, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        static_assert(std::is_integral_v<T>, "fetchAnd() requires an integral T");
+#ifdef SILICA_ATOMIC_MASK_INTERRUPTS
+        (void)order;
+        InterruptMask mask;
+        const T previous = value;
+        value = previous & operand;
+        return previous;
+#else
+        return value.fetch_and(operand, order);
+#endif
+    }
+
+    /** \brief Sets the value to the bitwise or of it and \p operand. \returns The value before. */
+    T fetchOr(T operand, std::memory_order order = std::memory_order_seq_cst) noexcept
+    {
+        static_assert(std::is_integral_v<T>, "fetchOr() requires an integral T");
+#ifdef SILICA_ATOMIC_MASK_INTERRUPTS
+        (void)order;
+        InterruptMask mask;
+        const T previous = value;
+        value = previous | operand;
+        return previous;
+#else
+        return value.fetch_or(operand, order);
+#endif
+    }
+
+    /** \brief Returns true if the operations on this Atomic never take a lock, nor mask interrupts. */
+    static constexpr bool isLockFree()
+    {
+#ifdef SILICA_ATOMIC_MASK_INTERRUPTS
+        return false;
+#else
+        return std::atomic<T>::is_always_lock_free;
+#endif
+    }
+
+    /// \cond DEVELOPER_DOC
+private:
+    static constexpr std::memory_order failureOrderOf(std::memory_order order)
+    {
+        if(order == std::memory_order_acq_rel)
+        {
+            return std::memory_order_acquire;
+        }
+        if(order == std::memory_order_release)
+        {
+            return std::memory_order_relaxed;
+        }
+        return order;
+    }
+
+#ifdef SILICA_ATOMIC_MASK_INTERRUPTS
+    T value;
+#else
+    std::atomic<T> value;
+#endif
+    /// \endcond
+};
+
+}
+
+#endif // SILICA_ATOMIC_H
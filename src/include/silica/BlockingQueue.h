@@ -0,0 +1,214 @@
+#ifndef SILICA_BLOCKING_QUEUE_H
+#define SILICA_BLOCKING_QUEUE_H
+
+#include <silica/Array.h>
+#include <silica/Macros.h>
+#include <silica/Mutex.h>
+#include <silica/RingBuffer.h>
+#include <silica/Semaphore.h>
+#include <silica/UnitsOfTime.h>
+
+namespace Silica
+{
+
+/**
+\brief BlockingQueue implements a thread safe first-in-first-out queue, where consumers sleep until data arrives.
+
+BlockingQueue<T,S> lets producer threads hand over elements to consumer threads without any polling. A consumer calling pop() spins briefly
+and is then parked by the operating system until an element is pushed. Each push wakes at most one waiting consumer, so pushing a single
+element never causes a thundering herd.
+
+Regarding capacity, BlockingQueue<T,S> behaves like @ref the_concept_of_container_capacity "the Array<T,S> class":
+
+- With <code>S > 0</code> the queue holds at most \c S elements, and push() blocks while the queue is full.
+- With <code>S = 0</code> the queue grows as needed, and push() never blocks.
+
+### Examples
+
+```cpp
+#include <silica/BlockingQueue.h>
+
+Silica::BlockingQueue<int, 64> queue;
+
+// Producer thread
+queue.push(42);
+
+// Consumer thread
+int value = queue.pop();
+
+// Consumer thread with a timeout
+if( queue.popFor(value, 10'000_us) )
+{
+    ...
+}
+```
+
+### Requirements for <code>T</code>
+
+\c T must provide the following:
+
+<table>
+<tr><td><code>T()</code></td><td>A default constructor</td></tr>
+<tr><td><code>~T()</code></td><td>A public destructor</td></tr>
+<tr><td><code>T& operator=(const T &other)</code></td><td>The assignment operator.</td></tr>
+</table>
+
+\ingroup Containers
+\ingroup Core
+*/
+template <typename T, size_t S = 0>
+class BlockingQueue
+{
+    DISABLE_COPY(BlockingQueue);
+    DISABLE_MOVE(BlockingQueue);
+
+public:
+
+    /** \brief Creates an empty BlockingQueue. */
+    BlockingQueue()
+    {
+        d.elements.setOverflowPolicy(OverflowPolicy::SkipNewData);
+    }
+
+    /** \brief Appends a copy of \p element to the end of the queue, and wakes a single waiting consumer.
+
+    For queues with static capacity, push() blocks while the queue is full.
+    \param element The element to append.
+    */
+    void push(const T &element)
+    {
+        if constexpr (S > 0)
+        {
+            d.freeSlots.acquire();
+        }
+        {
+            MutexLocker locker(d.mutex);
+            d.elements.push(element);
+        }
+        d.availableElements.release(1);
+    }
+
+    /** \brief Removes and returns the first element of the queue, blocking until one is available.
+    \returns The first element of the queue.
+    */
+    T pop()
+    {
+        d.availableElements.acquire();
+        return takeFirst();
+    }
+
+    /** \brief Removes the first element of the queue, blocking for at most \p timeout until one is available.
+    \param destination Is assigned the first element of the queue, if any.
+    \param timeout The maximum time to wait for an element.
+    \returns True if an element was assigned to \p destination, false if \p timeout expired.
+    */
+    bool popFor(T &destination, MicroSeconds timeout)
+    {
+        if( ! d.availableElements.tryAcquireFor(timeout) )
+        {
+            return false;
+        }
+        destination = takeFirst();
+        return true;
+    }
+
+    /** \brief Removes the first element of the queue if one is available without blocking.
+    \param destination Is assigned the first element of the queue, if any.
+    \returns True if an element was assigned to \p destination, false if the queue was empty.
+    */
+    bool tryPop(T &destination)
+    {
+        if( ! d.availableElements.tryAcquire() )
+        {
+            return false;
+        }
+        destination = takeFirst();
+        return true;
+    }
+
+    /** \brief Moves all elements currently in the queue to the end of \p destination, without blocking.
+
+    The queue is locked only once for the whole batch. If \p destination has static capacity and runs full, the remaining elements are left in the queue.
+    \param destination The Array to append the elements to.
+    \returns The number of elements appended to \p destination.
+    */
+    size_t drainTo(Array<T> &destination)
+    {
+        const size_t taken = d.availableElements.tryAcquireUpTo(size_t(-1));
+        if(taken == 0)
+        {
+            return 0;
+        }
+
+        size_t moved = 0;
+        {
+            MutexLocker locker(d.mutex);
+            while(moved < taken)
+            {
+                if( ! destination.append(d.elements.peek()) )
+                {
+                    break;
+                }
+                d.elements.pop();
+                moved++;
+            }
+        }
+
+        if(moved < taken)
+        {
+            d.availableElements.release(int32_t(taken - moved));
+        }
+        if constexpr (S > 0)
+        {
+            if(moved > 0)
+            {
+                d.freeSlots.release(int32_t(moved));
+            }
+        }
+        return moved;
+    }
+
+    /** \brief Returns the number of elements currently in the queue.
+    \note In a multithreaded context, the value may be outdated once returned.
+    */
+    size_t size() const
+    {
+        return size_t(d.availableElements.available() > 0 ? d.availableElements.available() : 0);
+    }
+
+    /** \brief Returns the capacity of the queue. For queues with dynamic capacity this is the current capacity.*/
+    size_t capacity() const
+    {
+        return d.elements.capacity();
+    }
+
+private:
+    /// \cond DEVELOPER_DOC
+    T takeFirst()
+    {
+        T result;
+        {
+            MutexLocker locker(d.mutex);
+            result = d.elements.peek();
+            d.elements.pop();
+        }
+        if constexpr (S > 0)
+        {
+            d.freeSlots.release(1);
+        }
+        return result;
+    }
+
+    struct
+    {
+        Mutex mutex{"BlockingQueue::mutex"};
+        RingBuffer<T, S> elements;
+        Semaphore availableElements{0};
+        Semaphore freeSlots{int32_t(S)};
+    } d;
+    /// \endcond
+};
+
+}
+
+#endif // SILICA_BLOCKING_QUEUE_H
@@ -1,6 +1,6 @@
-#include <silica/LoggingSystem.h>
+#include <silica/LogRateLimit.h>
 #ifndef DOXYGEN
-    #define ContainerWarning(message, ...) WARN(message, ##__VA_ARGS__)
+    #define ContainerWarning(message, ...) WARN_RATE_LIMITED(SILICA_CONTAINER_WARNINGS_PER_SECOND, message, ##__VA_ARGS__)
 #endif
 
 #ifndef SILICA_ARRAY_INITIAL_CAPACITY
@@ -134,6 +134,20 @@
     #endif
 #endif
 
+// ----------------------------------------------------------------
+// RINGBUFFER STATISTICS
+
+#ifdef DOXYGEN
+    /*! Enables the push, drop, overwrite and high-water mark counters of all Silica::RingBuffer instances.
+    By default, the counters are disabled and take up no space.
+
+    The macro changes the layout of every RingBuffer, so it must be the same in every translation unit of a program. Do not define it
+    in a source file. Turn on the CMake option of the same name instead, which defines it for silica and everything linking to it.
+    \see Silica::RingBuffer::statistics()
+    */
+#define SILICA_ENABLE_RINGBUFFER_STATISTICS
+#endif
+
 // ----------------------------------------------------------------
 // MODIFIERS
 
@@ -146,6 +160,8 @@
     };
     ```
 
-    Exactely how \c SILICA_VOLATILE expands is dependent on the target platform.
+    Exactely how \c SILICA_VOLATILE expands is dependent on the target platform. Currently, it expands to nothing on all of them.
+    \note \c volatile neither makes read-modify-write operations atomic nor orders memory accesses. Share state between threads, or
+    between main code and interrupt handlers, with Silica::Atomic instead.
     */
-#define SILICA_VOLATILE //Figure out how to make things volatile without breaking const correctness.... Shit fuck!
+#define SILICA_VOLATILE
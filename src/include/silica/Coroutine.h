@@ -0,0 +1,290 @@
+#ifndef SILICA_COROUTINE_H
+#define SILICA_COROUTINE_H
+
+#include <coroutine>
+#include <optional>
+#include <tuple>
+#include <stddef.h>
+
+#include <silica/Application.h>
+#include <silica/EventGenerator.h>
+#include <silica/IODevice.h>
+#include <silica/SignalSlot.h>
+#include <silica/UnitsOfTime.h>
+
+#ifndef SILICA_COROUTINE_FRAME_MAX_POOLED_SIZE
+    /*! The largest coroutine frame, in bytes, that is recycled by the Silica::CoroutineFrameAllocator. Larger frames are allocated with \c malloc every time. */
+    #define SILICA_COROUTINE_FRAME_MAX_POOLED_SIZE 4096
+#endif
+
+#ifndef SILICA_COROUTINE_READABLE_POLL_INTERVAL
+    /*! The interval, in microseconds, at which readable() checks an IODevice that has not emitted IODevice::dataReady. */
+    #define SILICA_COROUTINE_READABLE_POLL_INTERVAL 1000
+#endif
+
+namespace Silica
+{
+
+/** \brief CoroutineFrameAllocator recycles the frames of [Coroutines](\ref Coroutine).
+
+Frames are kept in free lists by size class, powers of two from 64 bytes up to \ref SILICA_COROUTINE_FRAME_MAX_POOLED_SIZE. Once a
+Coroutine of a given size has run to completion, starting another of the same size reuses its frame and does not touch the heap.
+The free lists of allocate() are per thread, and a block is returned to the free list of the thread releasing it, so a frame must be
+released on the thread that allocated it. Blocks that may be released on any thread, like the state shared by a Promise and its
+Future, come from allocateShared() instead, whose free lists are shared by all threads and guarded by a Mutex.
+
+\ingroup Core
+*/
+class CoroutineFrameAllocator
+{
+public:
+    /** \brief Returns a block of at least \p size bytes. */
+    static void *allocate(size_t size);
+
+    /** \brief Returns the block \p frame of \p size bytes to the free list of its size class. */
+    static void deallocate(void *frame, size_t size);
+
+    /** \brief Returns a block of at least \p size bytes, which may be released by deallocateShared() on any thread. */
+    static void *allocateShared(size_t size);
+
+    /** \brief Returns the block \p frame of \p size bytes, obtained from allocateShared(), to the shared free list of its size class. */
+    static void deallocateShared(void *frame, size_t size);
+
+    /** \brief Returns the number of blocks the calling thread has allocated from the heap so far, by allocate() or allocateShared(). */
+    static size_t heapAllocationCount();
+};
+
+
+/** \brief Coroutine is the return type of a coroutine that runs on the event loop of the Application.
+
+A function returning a Coroutine may use \c co_await on:
+
+ - a Signal<Ts...>, which suspends until the Signal is emitted and returns the emitted arguments: nothing for <tt>Signal<></tt>,
+   the value for <tt>Signal<T></tt> and a <tt>std::tuple<Ts...></tt> otherwise.
+ - sleepFor(), which suspends for a given time. The event loop sleeps until the time is due rather than polling the clock.
+ - readable(), which suspends until an IODevice has bytes available.
+ - another Coroutine, which suspends until that Coroutine has returned.
+
+The Coroutine starts running as soon as it is called, and runs until its first \c co_await. From then on it is always resumed on the event
+loop thread, in the pass following the event it waited for. Once it has returned and the Coroutine object is gone, its frame is released,
+so a Coroutine that is called and discarded runs detached. Awaiting does not allocate, as the state of each wait lives in the coroutine
+frame, and frames are recycled by the CoroutineFrameAllocator.
+
+```cpp
+Silica::Coroutine echo(Silica::Signal<int> &input, Silica::Signal<int> &output)
+{
+    while(true)
+    {
+        int value = co_await input;
+        co_await Silica::sleepFor(100'000_us);
+        emit output(value);
+    }
+}
+
+Silica::Coroutine handshake(Silica::Signal<int> &input, Silica::Signal<int> &output)
+{
+    co_await echo(input, output); // Never returns, as echo() loops forever.
+}
+```
+
+\warning A Signal must outlive the Coroutines waiting for it. A Coroutine still waiting when the Application is destroyed is never resumed nor released.
+
+\ingroup Core
+*/
+class Coroutine
+{
+    DISABLE_COPY(Coroutine);
+
+public:
+    /// \cond DEVELOPER_DOC
+    struct promise_type
+    {
+        Coroutine get_return_object() { return Coroutine(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        auto final_suspend() noexcept { return FinalAwaiter{}; }
+        void return_void() {}
+        void unhandled_exception();
+
+        static void *operator new(size_t size) { return CoroutineFrameAllocator::allocate(size); }
+        static void operator delete(void *frame, size_t size) { CoroutineFrameAllocator::deallocate(frame, size); }
+
+        // The Coroutine awaiting this one, resumed when this one returns.
+        std::coroutine_handle<> continuation;
+        bool isFinished = false;
+        // Set when the Coroutine object is gone, so the frame releases itself when done.
+        bool isDetached = false;
+    };
+    /// \endcond
+
+    Coroutine(Coroutine &&other) noexcept
+        : handle(other.handle)
+    {
+        other.handle = nullptr;
+    }
+
+    Coroutine & operator=(Coroutine &&other) noexcept;
+
+    ~Coroutine();
+
+    /** \brief Returns true once the coroutine has returned. */
+    bool isFinished() const { return ! handle || handle.promise().isFinished; }
+
+    /// \cond DEVELOPER_DOC
+    auto operator co_await() &&
+    {
+        struct Awaiter
+        {
+            std::coroutine_handle<promise_type> awaited;
+
+            bool await_ready() const { return ! awaited || awaited.promise().isFinished; }
+            void await_suspend(std::coroutine_handle<> handle) { awaited.promise().continuation = handle; }
+            void await_resume() {}
+        };
+        return Awaiter{handle};
+    }
+
+    auto operator co_await() &
+    {
+        return std::move(*this).operator co_await();
+    }
+    /// \endcond
+
+private:
+    /// \cond DEVELOPER_DOC
+    struct FinalAwaiter
+    {
+        bool await_ready() noexcept { return false; }
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+        void await_resume() noexcept {}
+    };
+
+    explicit Coroutine(std::coroutine_handle<promise_type> handle)
+        : handle(handle)
+    {}
+
+    void release();
+
+    std::coroutine_handle<promise_type> handle;
+    /// \endcond
+};
+
+
+/// \cond DEVELOPER_DOC
+
+/* Queues the resumption of \p handle on the event loop thread. */
+void resumeOnLoop(std::coroutine_handle<> handle);
+
+template <typename ...Ts>
+class SignalAwaiter : public SignalWaiter<Ts...>
+{
+public:
+    explicit SignalAwaiter(Signal<Ts...> &signal)
+        : signal(signal)
+    {}
+
+    bool await_ready() const { return false; }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        this->handle = handle;
+        signal.addWaiter(this);
+    }
+
+    auto await_resume()
+    {
+        if constexpr (sizeof...(Ts) == 0)
+        {
+            return;
+        }
+        else if constexpr (sizeof...(Ts) == 1)
+        {
+            return std::get<0>(std::move(*values));
+        }
+        else
+        {
+            return std::move(*values);
+        }
+    }
+
+    void signalEmitted(Ts... parameters) override
+    {
+        values.emplace(parameters...);
+        resumeOnLoop(handle);
+    }
+
+private:
+    Signal<Ts...> &signal;
+    std::coroutine_handle<> handle;
+    std::optional<std::tuple<Ts...>> values;
+};
+
+template <typename ...Ts>
+SignalAwaiter<Ts...> operator co_await(Signal<Ts...> &signal)
+{
+    return SignalAwaiter<Ts...>(signal);
+}
+
+/*
+ * Awaiters of time and devices are EventGenerators living in the coroutine
+ * frame. They are woken at a deadline with wakeAt(), so a suspended
+ * Coroutine costs nothing in the event loop until then.
+ */
+class SleepAwaiter : public EventGenerator
+{
+public:
+    explicit SleepAwaiter(MicroSeconds duration);
+
+    bool await_ready() const;
+    void await_suspend(std::coroutine_handle<> handle);
+    void await_resume() {}
+
+private:
+    void visit() override;
+
+    MicroSeconds deadline;
+    std::coroutine_handle<> handle;
+};
+
+class ReadableAwaiter : public EventGenerator, public SignalWaiter<IODevice*, Array<Byte>*>
+{
+public:
+    explicit ReadableAwaiter(IODevice &device) : device(device) {}
+    ~ReadableAwaiter() override;
+
+    bool await_ready() const { return device.bytesAvailable() > 0; }
+    void await_suspend(std::coroutine_handle<> handle);
+    size_t await_resume() { return device.bytesAvailable(); }
+
+    void signalEmitted(IODevice *, Array<Byte> *) override;
+
+private:
+    void visit() override;
+    void waitForData();
+
+    IODevice &device;
+    std::coroutine_handle<> handle;
+    bool isWaitingForDataReady = false;
+};
+
+/// \endcond
+
+/** \brief Returns an awaitable that suspends the calling Coroutine for \p duration.
+ *  The resolution is that of Application::microsecondsSinceStart().
+ */
+inline SleepAwaiter sleepFor(MicroSeconds duration)
+{
+    return SleepAwaiter(duration);
+}
+
+/** \brief Returns an awaitable that suspends the calling Coroutine until \p device has bytes available.
+ *  The Coroutine is resumed when \p device emits IODevice::dataReady, or at the latest \ref SILICA_COROUTINE_READABLE_POLL_INTERVAL
+ *  microseconds after the bytes became available. \c co_await returns the number of bytes available.
+ */
+inline ReadableAwaiter readable(IODevice &device)
+{
+    return ReadableAwaiter(device);
+}
+
+}
+
+#endif // SILICA_COROUTINE_H
@@ -1,6 +1,10 @@
 #ifndef SILICA_EVENT_GENERATOR_H
 #define SILICA_EVENT_GENERATOR_H
 
+#include <silica/Atomic.h>
+#include <silica/LoopStatistics.h>
+#include <silica/UnitsOfTime.h>
+
 namespace Silica
 {
 
@@ -10,6 +14,17 @@ namespace Silica
 
 An EventGenerator is meant to be subclassed to classes that respond to external events such as clock, serial ports, input devices, e.t.c.
 
+## Readiness
+
+The Application only visits EventGenerators that are ready. An EventGenerator becomes ready by calling wake(), and stops being ready
+right before visit() is called. Hence, an EventGenerator that needs to poll, e.g. a running timer, calls wake() again from within visit(),
+while an idle EventGenerator costs nothing in the event loop until it is woken, e.g. from an interrupt or another thread.
+
+An EventGenerator waiting for a point in time, such as a timer, calls wakeAt() instead. The Application keeps such EventGenerators ordered
+by their wake up time, and when nothing else is ready, the event loop sleeps until the earliest of them is due.
+
+A newly constructed EventGenerator is ready, so it is visited at least once.
+
 \ingroup Core
 
 */
@@ -19,19 +34,73 @@ public:
     /** \brief Constructs and registers a new EventGenerator.
 
     The constructor registers this EventGenerator in the event system, so when subclassing an EventGenerator, it is important to call this constructor from the extending class.
+    Registering and the unregistering done by the destructor are O(1) and allocate nothing. Both may be done from within a visit(), but must happen on the thread running the event loop.
     */
     EventGenerator();
 
     virtual ~EventGenerator();
 
+    /** \brief Marks this EventGenerator as ready, so it is visited in the next pass of the event loop.
+
+    Calling wake() on an EventGenerator that is already ready does nothing. wake() does not block, allocate nor lock and may be called from any thread or from an interrupt.
+
+    The destructor waits for wake() calls already running on other threads to return, so a wake() racing the destruction either
+    completes before the EventGenerator is forgotten by the Application, or sees it unregistered and does nothing. A wake() must
+    however not be started on an EventGenerator whose destructor has returned, so code waking from another thread must stop doing so,
+    e.g. by disconnecting its interrupt handler, before the EventGenerator is destroyed.
+    */
+    void wake();
+
+    /** \brief Wakes this EventGenerator once Application::microsecondsSinceStart() has reached \p time.
+
+    A later call to wakeAt() replaces the pending wake up time. A \p time that has already passed wakes this EventGenerator in the next pass.
+    Unlike wake(), wakeAt() must be called on the thread running the event loop.
+    */
+    void wakeAt(MicroSeconds time);
+
+    /** \brief Cancels the wake up time set with wakeAt(), if any. Must be called on the thread running the event loop. */
+    void cancelWakeAt();
+
+    /** \brief Returns how often and for how long this EventGenerator has been visited.
+
+    Only measured when built with \ref SILICA_ENABLE_LOOP_INSTRUMENTATION. Otherwise, all values are 0.
+    May be called from any thread while the event loop is running.
+    */
+    DurationStatistics visitStatistics() const;
+
+    /** \brief Sets the statistics returned by visitStatistics() to 0. */
+    void resetVisitStatistics();
+
 private:
     /// \cond DEVELOPER_DOC
     friend class Application;
+
+    void waitForWakesInProgress();
+
+    struct
+    {
+        Atomic<bool> isReady{false};
+        EventGenerator *nextReady = nullptr;
+
+        Atomic<bool> isRegistered{false};
+        // The number of wake() calls currently running, which the destructor waits for.
+        Atomic<unsigned> wakesInProgress{0};
+        EventGenerator *previousRegistered = nullptr;
+        EventGenerator *nextRegistered = nullptr;
+
+        bool isTimed = false;
+        MicroSeconds wakeUpTime{0};
+        EventGenerator *previousTimed = nullptr;
+        EventGenerator *nextTimed = nullptr;
+
+        [[no_unique_address]] DurationCounters visitCounters;
+    } d;
     /// \endcond
 
     /** \brief Is called periodically from the main event loop to allow the EventGenerator to process data and emit signals if appropriate.
 
     visit() is where you should implement your logic to work on data originating from, e.g. interrupts or file descriptors.
+    visit() is only called when this EventGenerator has been woken. Call wake() from visit() to be visited again in the next pass.
     */
     virtual void visit() = 0;
 };
@@ -0,0 +1,166 @@
+#ifndef SILICA_FILE_LOG_SINK_H
+#define SILICA_FILE_LOG_SINK_H
+
+#if ! ( \
+       defined(SILICA_OS_WINDOWS) \
+    || defined(SILICA_OS_LINUX) \
+    || defined(SILICA_OS_MACOS) )
+
+        #error "FileLogSink requires an operating system providing files."
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <silica/LogFields.h>
+#include <silica/LoggingSystem.h>
+#include <silica/Macros.h>
+#include <silica/UnitsOfTime.h>
+
+#ifndef SILICA_FILE_LOG_SINK_CHUNK_SIZE
+    /*! The size in bytes of each of the chunks a Silica::FileLogSink buffers its text in. */
+    #define SILICA_FILE_LOG_SINK_CHUNK_SIZE 4096
+#endif
+
+#ifndef SILICA_FILE_LOG_SINK_CHUNKS
+    /*! The number of chunks a Silica::FileLogSink buffers. Once all are full, they are written with a single system call. */
+    #define SILICA_FILE_LOG_SINK_CHUNKS 16
+#endif
+
+namespace Silica
+{
+
+/** \brief FileLogSink writes log entries to a file, in batches, and rotates the file when it grows too large.
+
+The text of the entries is collected in \ref SILICA_FILE_LOG_SINK_CHUNKS chunks of \ref SILICA_FILE_LOG_SINK_CHUNK_SIZE bytes. The chunks
+are written with a single \c writev call when all are full, when the oldest buffered entry is older than flushDelay(), and on flush().
+Logging to a FileLogSink therefore costs one system call per batch, instead of one per line. The delay is only checked when an entry
+arrives, so a quiet program keeps its last entries buffered until LoggingSystem::flush() is called, e.g. from a CoarseTimer.
+
+Once the file reaches maximumFileSize(), it is renamed by appending \c ".1", older files are shifted to \c ".2" and so on, and a new
+file is started. At most maximumFiles() renamed files are kept.
+
+```cpp
+Silica::FileLogSink fileSink("/var/log/gateway.log");
+fileSink.setMaximumFileSize(10 * 1024 * 1024);
+fileSink.setSyncPolicy(Silica::FileLogSink::SyncPolicy::OnRotation);
+Silica::LoggingSystem::instance()->addSink(&fileSink);
+```
+
+The entries are written as the text of LogRecord, or, with Format::JsonLines, as one JSON object per line, which collectors read
+without parsing text, see LogFields::renderJson().
+
+FileLogSink only flushes when the LoggingSystem flushes explicitly, or on FATAL, as its flushInterval() is set to the largest possible.
+
+\ingroup Logging
+*/
+class FileLogSink : public LogSink
+{
+    DISABLE_COPY(FileLogSink);
+    DISABLE_MOVE(FileLogSink);
+
+public:
+    /** \brief When the written data is forced to the storage device, with \c fsync. */
+    enum class SyncPolicy
+    {
+        Never,          ///< Left to the operating system
+        OnRotation,     ///< Before a file is rotated away, and when the sink is destroyed
+        OnFlush         ///< On every flush(), so entries survive a power loss once LoggingSystem::flush() returns
+    };
+
+    /** \brief How the entries are written. */
+    enum class Format
+    {
+        Text,           ///< The text of LogRecord, the default
+        JsonLines       ///< One JSON object per line, including the structured fields of LOG_KV
+    };
+
+    /** \brief Opens \p path for appending, creating it if needed. \p path is copied. Check isOpen() for failure. */
+    explicit FileLogSink(const char *path);
+
+    /** \brief Writes the buffered entries and closes the file. Remove the sink from the LoggingSystem first. */
+    ~FileLogSink() override;
+
+    /** \brief Returns true if the file could be opened. */
+    bool isOpen() const;
+
+    void sinkRecord(const LogRecord &record) override;
+
+    /** \brief Writes the buffered entries. */
+    void flush() override;
+
+    /** \brief Sets the size in bytes at which the file is rotated. 0, the default, never rotates. */
+    void setMaximumFileSize(uint64_t bytes);
+    uint64_t maximumFileSize() const;
+
+    /** \brief Sets how many rotated files are kept. Defaults to 5. */
+    void setMaximumFiles(unsigned count);
+    unsigned maximumFiles() const;
+
+    /** \brief Sets how long entries may stay buffered. Defaults to 1000 ms. */
+    void setFlushDelay(MilliSeconds delay);
+    MilliSeconds flushDelay() const;
+
+    void setSyncPolicy(SyncPolicy policy);
+    SyncPolicy syncPolicy() const;
+
+    void setFormat(Format format);
+    Format format() const;
+
+    /** \brief Returns the number of batches written so far. On Linux, each batch takes a single system call. */
+    uint64_t writeCalls() const;
+
+    /// \cond DEVELOPER_DOC
+    /** A piece of the data handed to platformWrite(). */
+    struct Segment
+    {
+        const char *data;
+        size_t length;
+    };
+
+private:
+    void writeChunks();
+    void rotate();
+    void append(const char *text, size_t length);
+
+    /** Opens the file for appending and creating, and returns its size, or -1 on failure.
+        \addtogroup PlatformRequiresImplementation */
+    int64_t platformOpen();
+
+    /** Writes all of \p segments to the file, in one call if the platform allows.
+        \addtogroup PlatformRequiresImplementation */
+    bool platformWrite(const Segment *segments, size_t count);
+
+    /** Forces the written data to the storage device.
+        \addtogroup PlatformRequiresImplementation */
+    void platformSync();
+
+    /** \addtogroup PlatformRequiresImplementation */
+    void platformClose();
+
+    /** Returns milliseconds of a clock that never goes backwards.
+        \addtogroup PlatformRequiresImplementation */
+    static uint64_t platformMilliseconds();
+
+    struct
+    {
+        char path[FILENAME_MAX + 1];
+        intptr_t handle = -1;
+        uint64_t fileSize = 0;
+        uint64_t maximumFileSize = 0;
+        unsigned maximumFiles = 5;
+        uint64_t flushDelay = 1000;
+        SyncPolicy syncPolicy = SyncPolicy::Never;
+        Format format = Format::Text;
+        uint64_t writeCalls = 0;
+        uint64_t oldestEntryTime = 0;
+        char chunks[SILICA_FILE_LOG_SINK_CHUNKS][SILICA_FILE_LOG_SINK_CHUNK_SIZE];
+        size_t chunkLengths[SILICA_FILE_LOG_SINK_CHUNKS] = {};
+        size_t currentChunk = 0;
+    } d;
+    /// \endcond
+};
+
+}
+
+#endif // SILICA_FILE_LOG_SINK_H
@@ -0,0 +1,142 @@
+#ifndef SILICA_FLIGHT_RECORDER_LOG_SINK_H
+#define SILICA_FLIGHT_RECORDER_LOG_SINK_H
+
+#if ! ( \
+       defined(SILICA_OS_WINDOWS) \
+    || defined(SILICA_OS_LINUX) \
+    || defined(SILICA_OS_MACOS) )
+
+        #error "FlightRecorderLogSink requires an operating system providing memory mapped files."
+#endif
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+#include <silica/LoggingSystem.h>
+#include <silica/Macros.h>
+
+#ifndef SILICA_FLIGHT_RECORDER_RECORDS
+    /*! The default number of records a Silica::FlightRecorderLogSink keeps. */
+    #define SILICA_FLIGHT_RECORDER_RECORDS 4096
+#endif
+
+namespace Silica
+{
+
+/// \cond DEVELOPER_DOC
+
+/*
+ * The layout of a flight recorder file, shared with the reader tool. The
+ * header is followed by recordCount records of recordSize bytes, each a
+ * FlightRecord followed by the file name and the message, both null
+ * terminated and of fixed length. A record whose sequence is 0 is empty,
+ * or was being written when the process died.
+ */
+struct FlightRecorderHeader
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t recordCount;
+    uint32_t recordSize;
+    uint32_t fileNameLength;
+    uint32_t messageLength;
+    std::atomic<uint64_t> nextSequence;
+};
+
+struct FlightRecord
+{
+    std::atomic<uint64_t> sequence;     // 1 + the number of records written before this one
+    uint32_t line;
+    uint8_t type;
+    uint8_t reserved[3];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "The flight recorder shares atomics through a file");
+
+/// \endcond
+
+/** \brief FlightRecorderLogSink keeps the most recent log entries in a memory mapped file, so they survive a crash of the program.
+
+The file holds a header and a fixed number of fixed size records, used as a circular buffer. Every entry is copied into the next record
+of the mapping, which costs a \c memcpy and an atomic increment, and no system call. As the mapping is shared with the file, the
+operating system writes the records to the file even if the program crashes right after logging. Use
+\c silica_flight_recorder_reader to print the records, oldest first:
+
+```
+silica_flight_recorder_reader /var/log/gateway.flight
+```
+
+When the program starts again with the same file and geometry, recording continues where it stopped, so the file always holds the
+latest entries in order. Messages and file names are kept at \ref SILICA_LOGENTRY_MESSAGE_MAX_LENGTH and
+\ref SILICA_LOGENTRY_FILENAME_MAX_LENGTH characters.
+
+Recording is lock-free, so the sink may receive entries from several threads at once. The sink is
+[synchronous](\ref LogSink::setSynchronous()): with the asynchronous backend running, entries are recorded by the logging thread
+before they are staged, so none waits in a staging buffer when the program crashes. To also survive a power loss, call
+syncToStorage() where it matters, e.g. before a planned reboot.
+
+\ingroup Logging
+*/
+class FlightRecorderLogSink : public LogSink
+{
+    DISABLE_COPY(FlightRecorderLogSink);
+    DISABLE_MOVE(FlightRecorderLogSink);
+
+public:
+    /** \brief Maps \p path, creating or resizing it to hold \p recordCount records. Check isOpen() for failure. */
+    explicit FlightRecorderLogSink(const char *path, uint32_t recordCount = SILICA_FLIGHT_RECORDER_RECORDS);
+
+    /** \brief Unmaps the file. Remove the sink from the LoggingSystem first. */
+    ~FlightRecorderLogSink() override;
+
+    /** \brief Returns true if the file could be mapped. */
+    bool isOpen() const;
+
+    void sinkEntry(const LogEntry &entry) override;
+
+    /** \brief Blocks until the records are written to the storage device. */
+    void syncToStorage();
+
+    /** \brief Returns the number of entries recorded in the file, including those of earlier runs. */
+    uint64_t recordedEntries() const;
+
+    /// \cond DEVELOPER_DOC
+    static constexpr char magic[4] = {'S', 'L', 'F', 'R'};
+    static constexpr uint32_t version = 1;
+    static constexpr size_t headerSize = 64;
+    static constexpr size_t recordSize(uint32_t fileNameLength, uint32_t messageLength)
+    {
+        return (sizeof(FlightRecord) + fileNameLength + 1 + messageLength + 1 + 7) & ~size_t(7);
+    }
+    /// \endcond
+
+private:
+    /// \cond DEVELOPER_DOC
+    FlightRecord *record(uint64_t sequence) const;
+
+    /** Maps \p size bytes of the file at d.path, creating or resizing it as needed, and returns the mapping or nullptr.
+        \addtogroup PlatformRequiresImplementation */
+    void *platformMap(size_t size);
+
+    /** \addtogroup PlatformRequiresImplementation */
+    void platformSync();
+
+    /** \addtogroup PlatformRequiresImplementation */
+    void platformUnmap();
+
+    struct
+    {
+        char path[FILENAME_MAX + 1];
+        intptr_t file = -1;
+        intptr_t mapping = -1;
+        size_t size = 0;
+        FlightRecorderHeader *header = nullptr;
+        uint8_t *records = nullptr;
+        uint32_t recordCount = 0;
+    } d;
+    /// \endcond
+};
+
+}
+
+#endif // SILICA_FLIGHT_RECORDER_LOG_SINK_H
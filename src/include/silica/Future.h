@@ -0,0 +1,490 @@
+#ifndef SILICA_FUTURE_H
+#define SILICA_FUTURE_H
+
+#include <coroutine>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <stddef.h>
+
+#include <silica/Atomic.h>
+#include <silica/Coroutine.h>
+#include <silica/Macros.h>
+#include <silica/Task.h>
+
+namespace Silica
+{
+
+template <typename T> class Future;
+template <typename T> class Promise;
+
+/// \cond DEVELOPER_DOC
+
+/*
+ * The state shared by a Promise and its Future. It is allocated from the
+ * CoroutineFrameAllocator, so once the application has warmed up, creating
+ * a Promise does not touch the heap. It comes from the shared pool, as the
+ * last reference may well be released on another thread.
+ *
+ * The Promise may be fulfilled on any thread, while the continuation is
+ * attached on the loop thread. Whichever of the two comes last queues the
+ * continuation on the event loop, so it always runs there.
+ */
+class FutureStateBase
+{
+    DISABLE_COPY(FutureStateBase);
+    DISABLE_MOVE(FutureStateBase);
+
+public:
+    FutureStateBase() = default;
+
+    bool isReady() const { return d.flags.load(std::memory_order_acquire) & HasValue; }
+    bool isBroken() const { return d.flags.load(std::memory_order_acquire) & IsBroken; }
+
+    void acquireReference() { d.references.fetchAdd(1, std::memory_order_relaxed); }
+    void releaseReference();
+
+    // Called by the Promise once the value has been stored.
+    void publish();
+    // Called by the Promise when it is destroyed without a value.
+    void breakPromise();
+    // Takes over the reference of the Future, which is released once the continuation has run.
+    void attachContinuation(Task continuation);
+
+protected:
+    virtual ~FutureStateBase() = default;
+    virtual size_t allocatedSize() const = 0;
+
+private:
+    enum : unsigned
+    {
+        HasValue = 0x1,
+        HasContinuation = 0x2,
+        IsBroken = 0x4
+    };
+
+    void scheduleContinuation();
+
+    struct
+    {
+        Atomic<int> references{2};
+        Atomic<unsigned> flags{0};
+        Task continuation;
+    } d;
+};
+
+struct FutureNothing {};
+
+template <typename T>
+class FutureState : public FutureStateBase
+{
+public:
+    using Stored = typename std::conditional<std::is_void<T>::value, FutureNothing, T>::type;
+
+    static FutureState *create()
+    {
+        return new (CoroutineFrameAllocator::allocateShared(sizeof(FutureState))) FutureState();
+    }
+
+    std::optional<Stored> value;
+
+protected:
+    size_t allocatedSize() const override { return sizeof(FutureState); }
+};
+
+template <typename F, typename T>
+struct FutureContinuationResult
+{
+    using Type = typename std::invoke_result<F, T&>::type;
+};
+
+template <typename F>
+struct FutureContinuationResult<F, void>
+{
+    using Type = typename std::invoke_result<F>::type;
+};
+
+/// \endcond
+
+
+/** \brief Future holds a value that becomes available later, delivered by its Promise.
+
+A Future is obtained from a Promise, and becomes ready once the Promise is given a value, from any thread. The value can then be
+reacted upon in three ways, all of which run on the event loop thread:
+
+ - then() attaches a continuation that is called with the value, and returns a Future of what the continuation returns.
+ - A Coroutine can \c co_await the Future.
+ - whenAll() and whenAny() combine several Futures into one.
+
+```cpp
+Silica::Promise<int> promise;
+Silica::Future<int> answer = promise.future();
+app.post([p = std::move(promise)]() mutable { p.setValue(computeTheAnswer()); });
+
+answer.then([](int &value){
+    LOG("The answer is %d", value);   // Runs on the event loop thread
+});
+```
+
+The Promise and the Future share a small state, which is recycled by the CoroutineFrameAllocator, so it does not allocate in the
+steady state. A continuation is held in a Task, so its captures are limited to \ref SILICA_TASK_INLINE_SIZE bytes, less two pointers.
+
+A Future whose Promise is destroyed without a value never becomes ready, and its continuation is released without being called.
+
+Futures can be moved but not copied. T may be \c void.
+
+\ingroup Core
+*/
+template <typename T>
+class Future
+{
+    DISABLE_COPY(Future);
+
+public:
+    /** \brief Creates an invalid Future, not attached to any Promise. */
+    Future() = default;
+
+    Future(Future &&other) noexcept
+        : state(std::exchange(other.state, nullptr))
+    {}
+
+    Future &operator=(Future &&other) noexcept
+    {
+        if(this != &other)
+        {
+            release();
+            state = std::exchange(other.state, nullptr);
+        }
+        return *this;
+    }
+
+    ~Future()
+    {
+        release();
+    }
+
+    /** \brief Returns true if this Future is attached to a Promise and then() has not been called on it. */
+    bool isValid() const { return state != nullptr; }
+
+    /** \brief Returns true if the Promise has been given a value. */
+    bool isReady() const { return state && state->isReady(); }
+
+    /** \brief Returns true if the Promise was destroyed without giving a value. Such a Future never becomes ready. */
+    bool isBroken() const { return state && state->isBroken(); }
+
+    /** \brief Returns the value of a ready Future.
+     *  \note Only call this once isReady() has returned true. Only available when T is not \c void.
+     */
+    template <typename U = T, typename std::enable_if<!std::is_void<U>::value, int>::type = 0>
+    U &value()
+    {
+        return *state->value;
+    }
+
+    /** \brief Attaches \p continuation, which is called on the event loop thread with the value once this Future is ready.
+     *
+     *  The continuation is called with a reference to the value, or with no argument if T is \c void. Whatever it returns becomes
+     *  the value of the returned Future. A continuation attached to a Future that is already ready is called in the next pass of
+     *  the event loop, never from within then().
+     *
+     *  This Future is invalid afterwards.
+     *  \returns A Future of the return value of \p continuation.
+     */
+    template <typename F>
+    Future<typename FutureContinuationResult<F, T>::Type> then(F continuation);
+
+    /// \cond DEVELOPER_DOC
+    bool await_ready() const { return ! state || state->isReady(); }
+
+    void await_suspend(std::coroutine_handle<> handle)
+    {
+        state->acquireReference(); // Taken over by the continuation, as this Future keeps its own for await_resume().
+        state->attachContinuation([handle](){ handle.resume(); });
+    }
+
+    auto await_resume()
+    {
+        if constexpr (std::is_void<T>::value)
+        {
+            return;
+        }
+        else
+        {
+            return std::move(*state->value);
+        }
+    }
+    /// \endcond
+
+private:
+    /// \cond DEVELOPER_DOC
+    friend class Promise<T>;
+
+    explicit Future(FutureState<T> *state)
+        : state(state)
+    {}
+
+    void release()
+    {
+        if(state)
+        {
+            std::exchange(state, nullptr)->releaseReference();
+        }
+    }
+
+    FutureState<T> *state = nullptr;
+    /// \endcond
+};
+
+
+/** \brief Promise is the sending end of a Future.
+
+Create a Promise where the asynchronous work is started, hand its future() to whoever waits for the result, and call setValue()
+once the result is known. setValue() may be called from any thread, e.g. a ThreadPool worker, and is wait free.
+
+\ingroup Core
+*/
+template <typename T>
+class Promise
+{
+    DISABLE_COPY(Promise);
+
+public:
+    /** \brief Creates a Promise that has not been given a value. */
+    Promise()
+        : state(FutureState<T>::create())
+    {}
+
+    Promise(Promise &&other) noexcept
+        : state(std::exchange(other.state, nullptr)),
+          futureTaken(other.futureTaken)
+    {}
+
+    Promise &operator=(Promise &&other) noexcept
+    {
+        if(this != &other)
+        {
+            release();
+            state = std::exchange(other.state, nullptr);
+            futureTaken = other.futureTaken;
+        }
+        return *this;
+    }
+
+    ~Promise()
+    {
+        release();
+    }
+
+    /** \brief Returns the Future of this Promise. May only be called once. Later calls return an invalid Future. */
+    Future<T> future()
+    {
+        if( ! state || futureTaken )
+        {
+            return Future<T>();
+        }
+        futureTaken = true;
+        return Future<T>(state);
+    }
+
+    /** \brief Gives this Promise its value, making the Future ready. Only the first value given is kept. */
+    template <typename U = T, typename std::enable_if<!std::is_void<U>::value, int>::type = 0>
+    void setValue(U value)
+    {
+        if(state && ! state->value)
+        {
+            state->value.emplace(std::move(value));
+            state->publish();
+        }
+    }
+
+    /** \brief Makes the Future of a Promise<void> ready. */
+    template <typename U = T, typename std::enable_if<std::is_void<U>::value, int>::type = 0>
+    void setValue()
+    {
+        if(state && ! state->value)
+        {
+            state->value.emplace();
+            state->publish();
+        }
+    }
+
+private:
+    /// \cond DEVELOPER_DOC
+    void release()
+    {
+        if( ! state )
+        {
+            return;
+        }
+        if( ! state->value )
+        {
+            state->breakPromise();
+        }
+        if( ! futureTaken )
+        {
+            state->releaseReference(); // The reference the Future would have had.
+        }
+        std::exchange(state, nullptr)->releaseReference();
+    }
+
+    FutureState<T> *state;
+    bool futureTaken = false;
+    /// \endcond
+};
+
+
+/// \cond DEVELOPER_DOC
+
+template <typename T>
+template <typename F>
+Future<typename FutureContinuationResult<F, T>::Type> Future<T>::then(F continuation)
+{
+    using R = typename FutureContinuationResult<F, T>::Type;
+
+    Promise<R> promise;
+    Future<R> result = promise.future();
+    if( ! state )
+    {
+        return result;
+    }
+
+    FutureState<T> *source = std::exchange(state, nullptr);
+    source->attachContinuation([source, continuation = std::move(continuation), promise = std::move(promise)]() mutable {
+        if constexpr (std::is_void<T>::value && std::is_void<R>::value)
+        {
+            continuation();
+            promise.setValue();
+        }
+        else if constexpr (std::is_void<T>::value)
+        {
+            promise.setValue(continuation());
+        }
+        else if constexpr (std::is_void<R>::value)
+        {
+            continuation(*source->value);
+            promise.setValue();
+        }
+        else
+        {
+            promise.setValue(continuation(*source->value));
+        }
+    });
+    return result;
+}
+
+/*
+ * The combinators keep their state alive through the continuations they
+ * attach, so it is freed when the last of them has run or, if a Promise
+ * was broken, has been released without running.
+ */
+template <typename S>
+class FutureCombinatorReference
+{
+    DISABLE_COPY(FutureCombinatorReference);
+
+public:
+    explicit FutureCombinatorReference(S *state)
+        : state(state)
+    {
+        state->references.fetchAdd(1, std::memory_order_relaxed);
+    }
+
+    FutureCombinatorReference(FutureCombinatorReference &&other) noexcept
+        : state(std::exchange(other.state, nullptr))
+    {}
+
+    ~FutureCombinatorReference()
+    {
+        if(state && (state->references.fetchSub(1, std::memory_order_acq_rel) == 1))
+        {
+            delete state;
+        }
+    }
+
+    S *get() const { return state; }
+    S *operator->() const { return state; }
+
+private:
+    S *state;
+};
+
+template <typename ...Ts>
+struct WhenAllState
+{
+    Atomic<int> references{0};
+    Promise<std::tuple<Ts...>> promise;
+    std::tuple<std::optional<Ts>...> values;
+    size_t remaining = sizeof...(Ts);
+
+    template <size_t I, typename U>
+    void store(U &value)
+    {
+        std::get<I>(values).emplace(std::move(value));
+        if(--remaining == 0)
+        {
+            promise.setValue(std::apply([](auto &...stored){ return std::tuple<Ts...>(std::move(*stored)...); }, values));
+        }
+    }
+};
+
+template <typename ...Ts, size_t ...Is>
+void attachWhenAll(WhenAllState<Ts...> *all, std::tuple<Future<Ts>...> &futures, std::index_sequence<Is...>)
+{
+    (std::get<Is>(futures).then([all = FutureCombinatorReference<WhenAllState<Ts...>>(all)](Ts &value){
+        all->template store<Is>(value);
+    }), ...);
+}
+
+template <typename T>
+struct WhenAnyState
+{
+    Atomic<int> references{0};
+    Promise<std::pair<size_t, T>> promise;
+
+    void store(size_t index, T &value)
+    {
+        promise.setValue(std::pair<size_t, T>(index, std::move(value))); // Only the first value is kept.
+    }
+};
+
+/// \endcond
+
+/** \brief Returns a Future that becomes ready once all of \p futures are, holding their values in order.
+ *
+ *  The Futures must not be of type \c void. If any of their Promises is broken, the returned Future never becomes ready.
+ *  \relates Future
+ */
+template <typename ...Ts>
+Future<std::tuple<Ts...>> whenAll(Future<Ts> ...futures)
+{
+    static_assert(sizeof...(Ts) > 0, "whenAll() requires at least one Future.");
+    using State = WhenAllState<Ts...>;
+    FutureCombinatorReference<State> all(new State());
+    Future<std::tuple<Ts...>> result = all->promise.future();
+    std::tuple<Future<Ts>...> held(std::move(futures)...);
+    attachWhenAll(all.get(), held, std::index_sequence_for<Ts...>());
+    return result;
+}
+
+/** \brief Returns a Future that becomes ready as soon as one of \p futures is, holding its index among \p futures and its value.
+ *
+ *  All of \p futures must be of the same type, which must not be \c void. The values of the Futures becoming ready later are discarded.
+ *  \relates Future
+ */
+template <typename T, typename ...Ts>
+Future<std::pair<size_t, T>> whenAny(Future<T> first, Future<Ts> ...others)
+{
+    static_assert((std::is_same<T, Ts>::value && ...), "whenAny() requires Futures of the same type.");
+    using State = WhenAnyState<T>;
+    FutureCombinatorReference<State> any(new State());
+    Future<std::pair<size_t, T>> result = any->promise.future();
+    size_t index = 0;
+    first.then([any = FutureCombinatorReference<State>(any.get()), index](T &value){ any->store(index, value); });
+    ((index++, others.then([any = FutureCombinatorReference<State>(any.get()), index](T &value){ any->store(index, value); })), ...);
+    return result;
+}
+
+}
+
+#endif // SILICA_FUTURE_H
@@ -1,6 +1,8 @@
 #ifndef SILICA_LOG_ENTRY_H
 #define SILICA_LOG_ENTRY_H
 
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdarg.h>
 
@@ -13,15 +15,107 @@
 #define SILICA_LOGENTRY_FILENAME_MAX_LENGTH 50
 #endif
 
+#ifndef SILICA_LOGENTRY_FIELDS_MAX_SIZE
+/*! The number of bytes the structured fields of LOG_KV may take in a Silica::LogEntry, see Silica::LogFields. */
+#define SILICA_LOGENTRY_FIELDS_MAX_SIZE 64
+#endif
+
+/*! The level of LOG_TRACE, see Silica::LogEntry::Type::Trace. */
+#define SILICA_LOG_LEVEL_TRACE 0
+/*! The level of LOG_DEBUG, see Silica::LogEntry::Type::Debug. */
+#define SILICA_LOG_LEVEL_DEBUG 1
+/*! The level of LOG and LOG_INFO, see Silica::LogEntry::Type::Log. */
+#define SILICA_LOG_LEVEL_INFO 2
+/*! The level of WARN, see Silica::LogEntry::Type::Warning. */
+#define SILICA_LOG_LEVEL_WARNING 3
+/*! The level of FATAL, see Silica::LogEntry::Type::Fatal. */
+#define SILICA_LOG_LEVEL_FATAL 4
+
+/*! The base name of the current source file, shortened to \ref SILICA_LOGENTRY_FILENAME_MAX_LENGTH characters at compile time, as
+a <tt>const Silica::SourceFileName &</tt> of static storage. All uses within one file share one object. */
+#define SILICA_SOURCE_FILE_NAME (Silica::staticSourceFileName<Silica::SourceFileName(__FILE__)>)
 
 
 namespace Silica
 {
 
+/**
+\brief SourceFileName is the base name of a source file, computed at compile time.
+
+Directories are stripped, and names longer than \ref SILICA_LOGENTRY_FILENAME_MAX_LENGTH are shortened by replacing their middle
+with "...". Use \ref SILICA_SOURCE_FILE_NAME for the current file, which keeps the name in static storage, so that a LogEntry can
+refer to it instead of copying it.
+
+The name is a public member, so that a SourceFileName can be a template argument.
+\ingroup Logging
+*/
+struct SourceFileName
+{
+    consteval SourceFileName(const char *path)
+    {
+        shorten(path, name);
+    }
+
+    /** \brief Writes the base name of \p path to \p name, shortened like the name of a SourceFileName. For names only known at
+     *  runtime. */
+    static constexpr void shorten(const char *path, char (&name)[SILICA_LOGENTRY_FILENAME_MAX_LENGTH + 1])
+    {
+        const char *baseName = path;
+        for(const char *c = path; *c; c++)
+        {
+            if( (*c == '/') || (*c == '\\') )
+            {
+                baseName = c + 1;
+            }
+        }
+        size_t length = 0;
+        while(baseName[length])
+        {
+            length++;
+        }
+
+        if(length <= SILICA_LOGENTRY_FILENAME_MAX_LENGTH)
+        {
+            for(size_t i = 0; i < length; i++)
+            {
+                name[i] = baseName[i];
+            }
+            name[length] = 0;
+            return;
+        }
+        const size_t elisionSize = 3;
+        const size_t leftPartSize = (SILICA_LOGENTRY_FILENAME_MAX_LENGTH - elisionSize) / 2;
+        const size_t rightPartSize = SILICA_LOGENTRY_FILENAME_MAX_LENGTH - elisionSize - leftPartSize;
+        for(size_t i = 0; i < leftPartSize; i++)
+        {
+            name[i] = baseName[i];
+        }
+        for(size_t i = 0; i < elisionSize; i++)
+        {
+            name[leftPartSize + i] = '.';
+        }
+        for(size_t i = 0; i < rightPartSize; i++)
+        {
+            name[leftPartSize + elisionSize + i] = baseName[length - rightPartSize + i];
+        }
+        name[SILICA_LOGENTRY_FILENAME_MAX_LENGTH] = 0;
+    }
+
+    char name[SILICA_LOGENTRY_FILENAME_MAX_LENGTH + 1] = {};
+};
+
+/// \cond DEVELOPER_DOC
+template<SourceFileName fileName>
+inline constexpr const SourceFileName &staticSourceFileName = fileName;
+/// \endcond
+
 /**
 \brief LogEntry models a single entry in to the logging system.
 
 LogEntry models a single entry in to the logging system. This is the lowest level of granularty there exists in the logging system.
+
+An entry created for a source location is stamped with the time of a monotonic clock and the id of the thread creating it, so that
+the entries of several threads can be ordered and told apart.
 \ingroup Core
 \ingroup Logging
 
@@ -31,15 +125,21 @@ class LogEntry
 
 public:
 
+    /** \brief The level of an entry, from the least to the most severe. */
     enum class Type
     {
-        Log,
-        Warning,
-        Fatal
+        Trace = SILICA_LOG_LEVEL_TRACE,     ///< Detailed tracing, off unless enabled at runtime
+        Debug = SILICA_LOG_LEVEL_DEBUG,     ///< Information for debugging, off unless enabled at runtime
+        Log = SILICA_LOG_LEVEL_INFO,        ///< Information on the normal operation
+        Info = Log,
+        Warning = SILICA_LOG_LEVEL_WARNING, ///< Something went wrong, but the program continues
+        Fatal = SILICA_LOG_LEVEL_FATAL      ///< The program can not continue
     };
 
 
+    /** \brief Creates an empty entry, without timestamp or thread id. */
     LogEntry();
+    LogEntry(size_t line, const SourceFileName &originatingFile);
     LogEntry(size_t line, const char *originatingFile);
     LogEntry(size_t line, const char *originatingFile, const char *message);
     ~LogEntry();
@@ -48,6 +148,12 @@ public:
     void setMessage(const char * message, size_t length = 0);
     char const * const message() const;
 
+    /** \brief Refers to \p fileName, which must outlive the entry, e.g. be \ref SILICA_SOURCE_FILE_NAME. Nothing is copied. */
+    void setOriginatingFile(const SourceFileName &fileName);
+
+    /** \brief Copies the base name of \p fileName into the entry, shortened to \ref SILICA_LOGENTRY_FILENAME_MAX_LENGTH characters,
+     *  so \p fileName may be built at runtime and go away before a sink reads the entry. Prefer the SourceFileName overload, which
+     *  copies nothing. */
     void setOriginatingFile(const char *fileName);
     const char * originatingFile() const;
 
@@ -56,18 +162,49 @@ public:
 
     size_t originatingLine() const { return d.originatingLine; }
 
+    /** \brief Copies \p size bytes of structured fields, encoded by LogFields. At most \ref SILICA_LOGENTRY_FIELDS_MAX_SIZE bytes
+     *  are kept. */
+    void setFields(const uint8_t *fields, size_t size);
+
+    /** \brief Returns the structured fields of LOG_KV, to be read with LogFields::Reader. */
+    const uint8_t *fields() const { return d.fields; }
+    size_t fieldsSize() const { return d.fieldsSize; }
+
+    /** \brief Returns the nanoseconds of a monotonic clock when the entry was created. Only differences between timestamps are
+     *  meaningful. */
+    uint64_t timestamp() const { return d.timestamp; }
+    void setTimestamp(uint64_t nanoseconds) { d.timestamp = nanoseconds; }
+
+    /** \brief Returns the id the operating system gave the thread which created the entry. */
+    uint32_t threadId() const { return d.threadId; }
+    void setThreadId(uint32_t id) { d.threadId = id; }
+
 private:
+    void stamp();
+
+    /** Returns nanoseconds of a clock that never goes backwards. Called for every entry, so it should be cheap.
+        \addtogroup PlatformRequiresImplementation */
+    static uint64_t platformTimestamp();
+
+    /** Returns the id of the calling thread. Called for every entry, so it should be cheap.
+        \addtogroup PlatformRequiresImplementation */
+    static uint32_t platformThreadId();
+
     struct
     {
         size_t originatingLine;
         const size_t messageMaxLength = SILICA_LOGENTRY_MESSAGE_MAX_LENGTH;
-        const size_t orignatingFileMaxLength = SILICA_LOGENTRY_FILENAME_MAX_LENGTH;
-        char originatingFile[SILICA_LOGENTRY_FILENAME_MAX_LENGTH + 1];
+        const char *originatingFile = "";    // Null if the name was copied to copiedFile
+        char copiedFile[SILICA_LOGENTRY_FILENAME_MAX_LENGTH + 1];
+        uint64_t timestamp = 0;
+        uint32_t threadId = 0;
         char message[SILICA_LOGENTRY_MESSAGE_MAX_LENGTH
                      + 1 // For null
                      + 1 // To help figuring out elision
         ];
         Type type;
+        uint16_t fieldsSize = 0;
+        uint8_t fields[SILICA_LOGENTRY_FIELDS_MAX_SIZE];
     } d;
 
 };
@@ -0,0 +1,199 @@
+#ifndef SILICA_LOG_FIELDS_H
+#define SILICA_LOG_FIELDS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include <silica/LogEntry.h>
+#include <silica/LoggingSystem.h>
+
+/// \cond DEVELOPER_DOC
+#define SILICA_LOG_KV_ENTRY(entryType, ...) \
+{ \
+    if constexpr (static_cast<int>(entryType) >= SILICA_LOG_MINIMUM_LEVEL) \
+    { \
+        static Silica::LogLevelFilter silicaLogFilter(__FILE__, nullptr, entryType); \
+        if(silicaLogFilter.isEnabled()) \
+        { \
+            Silica::LogEntry le(__LINE__, SILICA_SOURCE_FILE_NAME); \
+            Silica::LogFields::encode(le, __VA_ARGS__); \
+            le.setType(entryType); \
+            Silica::LoggingSystem::instance()->sinkEntry(le); \
+        } \
+    } \
+}
+/// \endcond
+
+/** Logs the pairs of keys and values given, e.g. <tt>LOG_KV("conn", id, "bytes", n)</tt>, as structured fields instead of a message.
+ *  Keys are strings, values integers, enums, floating point numbers, booleans or strings. Nothing is formatted when logging. */
+#define LOG_KV(...) SILICA_LOG_KV_ENTRY(Silica::LogEntry::Type::Log, __VA_ARGS__)
+
+/** Warns with structured fields, see LOG_KV. */
+#define WARN_KV(...) SILICA_LOG_KV_ENTRY(Silica::LogEntry::Type::Warning, __VA_ARGS__)
+
+namespace Silica
+{
+
+/** \brief LogFields encodes the structured fields of LOG_KV into a LogEntry, and reads and renders them.
+
+Each field takes a byte for the length of its key, the key, a byte for the Type of its value, and the value. Integers are stored as
+variable length integers, so small numbers take a single byte, floating point numbers take 8 bytes, booleans one, and strings a length
+byte and their characters. Fields not fitting into the \ref SILICA_LOGENTRY_FIELDS_MAX_SIZE bytes of an entry are left out, keys and
+strings are cut at 255 characters.
+
+Sinks either iterate the fields with a Reader, or render them: LogRecord::text() appends them as <tt>conn=3 bytes=512</tt>, and
+renderJson() turns the whole entry into a JSON object, see FileLogSink::Format::JsonLines.
+
+\ingroup Logging
+*/
+class LogFields
+{
+public:
+    /** \brief The type of the value of a field. */
+    enum class Type : uint8_t
+    {
+        Signed = 'i',           ///< A zig-zag encoded variable length integer
+        Unsigned = 'u',         ///< A variable length integer
+        FloatingPoint = 'f',    ///< 8 bytes, a double
+        Boolean = 'b',          ///< 1 byte
+        String = 's'            ///< A length byte followed by as many characters, without a null terminator
+    };
+
+    /** \brief A field as read by Reader. The key and string values point into the entry and are not null terminated. */
+    struct Field
+    {
+        const char *key;
+        size_t keyLength;
+        Type type;
+        union
+        {
+            int64_t signedValue;
+            uint64_t unsignedValue;
+            double floatingPointValue;
+            bool booleanValue;
+        };
+        const char *stringValue;
+        size_t stringLength;
+    };
+
+    /** \brief Reads the fields of an entry, in the order they were logged. */
+    class Reader
+    {
+    public:
+        explicit Reader(const LogEntry &entry)
+            : d{entry.fields(), entry.fields() + entry.fieldsSize()}
+        {}
+
+        /** \brief Reads the next field into \p field. \returns False once all fields are read. */
+        bool next(Field &field);
+
+    private:
+        struct
+        {
+            const uint8_t *cursor;
+            const uint8_t *end;
+        } d;
+    };
+
+    /** \brief The longest text appendText() writes, not counting the terminating null. */
+    static constexpr size_t textMaxLength = 8 * SILICA_LOGENTRY_FIELDS_MAX_SIZE;
+
+    /** \brief The longest JSON object renderJson() writes, not counting the terminating null. */
+    static constexpr size_t jsonMaxLength = 64 + 6 * SILICA_LOGENTRY_FILENAME_MAX_LENGTH + 6 * SILICA_LOGENTRY_MESSAGE_MAX_LENGTH
+                                            + 8 * SILICA_LOGENTRY_FIELDS_MAX_SIZE;
+
+    /** \brief Encodes \p keysAndValues, alternating keys and values, as the fields of \p entry. Used by LOG_KV. */
+    template<typename... Args>
+    static void encode(LogEntry &entry, const Args&... keysAndValues)
+    {
+        static_assert(sizeof...(Args) % 2 == 0, "LOG_KV takes pairs of keys and values");
+        uint8_t buffer[SILICA_LOGENTRY_FIELDS_MAX_SIZE];
+        Encoder encoder{buffer, buffer + sizeof(buffer)};
+        encodePairs(encoder, keysAndValues...);
+        entry.setFields(buffer, encoder.cursor - buffer);
+    }
+
+    /** \brief Writes the fields of \p entry as <tt>key=value</tt>, separated by spaces, with string values in quotes.
+     *  \returns The number of characters written, at most \p capacity - 1, after which a null is written. */
+    static size_t appendText(const LogEntry &entry, char *text, size_t capacity);
+
+    /** \brief Writes \p entry as a JSON object, e.g.
+     *  <tt>{"type":"L","time":1520331,"thread":4711,"line":42,"file":"Gateway.cpp","message":"","conn":3,"bytes":512}</tt>, where
+     *  time is LogEntry::timestamp() and thread LogEntry::threadId().
+     *  \returns The number of characters written, at most \p capacity - 1, after which a null is written. */
+    static size_t renderJson(const LogEntry &entry, char *json, size_t capacity);
+
+private:
+    /// \cond DEVELOPER_DOC
+    struct Encoder
+    {
+        uint8_t *cursor;
+        uint8_t *end;
+        bool isFull = false;
+    };
+
+    static void encodeBytes(Encoder &encoder, const char *bytes, size_t length);
+    static void encodeKey(Encoder &encoder, const char *key);
+    static void encodeVariableLength(Encoder &encoder, Type type, uint64_t value);
+    static void encodeFloatingPoint(Encoder &encoder, double value);
+    static void encodeBoolean(Encoder &encoder, bool value);
+    static void encodeString(Encoder &encoder, const char *value);
+
+    static void encodePairs(Encoder &) {}
+
+    template<typename Value, typename... Rest>
+    static void encodePairs(Encoder &encoder, const char *key, const Value &value, const Rest&... rest)
+    {
+        uint8_t *fieldStart = encoder.cursor;
+        encodeKey(encoder, key);
+        encodeValue(encoder, value);
+        if(encoder.isFull)
+        {
+            encoder.cursor = fieldStart; // A field fits completely, or not at all
+            return;
+        }
+        encodePairs(encoder, rest...);
+    }
+
+    template<typename T>
+    static void encodeValue(Encoder &encoder, const T &value)
+    {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_convertible_v<T, const char*> && ! std::is_null_pointer_v<U>)
+        {
+            encodeString(encoder, value);
+        }
+        else if constexpr (std::is_same_v<U, bool>)
+        {
+            encodeBoolean(encoder, value);
+        }
+        else if constexpr (std::is_floating_point_v<U>)
+        {
+            encodeFloatingPoint(encoder, value);
+        }
+        else if constexpr (std::is_enum_v<U>)
+        {
+            encodeValue(encoder, static_cast<std::underlying_type_t<U>>(value));
+        }
+        else
+        {
+            static_assert(std::is_integral_v<U>, "LOG_KV supports integers, enums, floating point numbers, booleans and strings");
+            if constexpr (std::is_signed_v<U>)
+            {
+                const int64_t signedValue = value;
+                // Zig-zag, so that small negative numbers take few bytes, too.
+                encodeVariableLength(encoder, Type::Signed, (static_cast<uint64_t>(signedValue) << 1) ^ static_cast<uint64_t>(signedValue >> 63));
+            }
+            else
+            {
+                encodeVariableLength(encoder, Type::Unsigned, value);
+            }
+        }
+    }
+    /// \endcond
+};
+
+}
+
+#endif // SILICA_LOG_FIELDS_H
@@ -0,0 +1,122 @@
+#ifndef SILICA_LOG_RATE_LIMIT_H
+#define SILICA_LOG_RATE_LIMIT_H
+
+#include <silica/LoggingSystem.h>
+
+#ifndef SILICA_CONTAINER_WARNINGS_PER_SECOND
+    /*! The number of warnings per second each warning site of the containers, e.g. an out of bound Silica::Array::operator[](), logs
+    at most. The warnings beyond are counted, and reported as repeats. */
+    #define SILICA_CONTAINER_WARNINGS_PER_SECOND 10
+#endif
+
+/// \cond DEVELOPER_DOC
+#define SILICA_LIMITED_LOG_ENTRY(entryType, limitKind, limitCount, formatString, ...) \
+{ \
+    if constexpr (static_cast<int>(entryType) >= SILICA_LOG_MINIMUM_LEVEL) \
+    { \
+        static Silica::LogLevelFilter silicaLogFilter(__FILE__, nullptr, entryType); \
+        static Silica::LogRateLimit silicaLogRateLimit(limitKind, limitCount, __LINE__, SILICA_SOURCE_FILE_NAME, entryType); \
+        if(silicaLogFilter.isEnabled() && silicaLogRateLimit.admit()) \
+        { \
+            Silica::LogEntry le(__LINE__, SILICA_SOURCE_FILE_NAME); \
+            le.format(formatString, ##__VA_ARGS__);           \
+            le.setType(entryType); \
+            Silica::LoggingSystem::instance()->sinkEntry(le); \
+        } \
+    } \
+}
+/// \endcond
+
+/** Logs the first and then every \p n th message of this statement. Before each, a "Repeated ... times" entry counts the messages
+ *  left out. The left out ones cost an atomic increment. */
+#define LOG_EVERY_N(n, formatString, ...) SILICA_LIMITED_LOG_ENTRY(Silica::LogEntry::Type::Log, Silica::LogRateLimit::Kind::EveryN, n, formatString, ##__VA_ARGS__)
+
+/** Warns the first and then every \p n th time, see LOG_EVERY_N. */
+#define WARN_EVERY_N(n, formatString, ...) SILICA_LIMITED_LOG_ENTRY(Silica::LogEntry::Type::Warning, Silica::LogRateLimit::Kind::EveryN, n, formatString, ##__VA_ARGS__)
+
+/** Logs at most \p perSecond messages per second of this statement, in bursts of up to \p perSecond. The messages beyond are
+ *  counted, and reported with a "Repeated ... times" entry once the statement logs again, or on Silica::LoggingSystem::flush(). The
+ *  counted ones cost a read of a coarse clock and an atomic increment. */
+#define LOG_RATE_LIMITED(perSecond, formatString, ...) SILICA_LIMITED_LOG_ENTRY(Silica::LogEntry::Type::Log, Silica::LogRateLimit::Kind::PerSecond, perSecond, formatString, ##__VA_ARGS__)
+
+/** Warns at most \p perSecond times per second, see LOG_RATE_LIMITED. */
+#define WARN_RATE_LIMITED(perSecond, formatString, ...) SILICA_LIMITED_LOG_ENTRY(Silica::LogEntry::Type::Warning, Silica::LogRateLimit::Kind::PerSecond, perSecond, formatString, ##__VA_ARGS__)
+
+namespace Silica
+{
+
+/// \cond DEVELOPER_DOC
+/*
+ * The rate limit of one log statement, see LOG_EVERY_N and LOG_RATE_LIMITED.
+ *
+ * PerSecond is a token bucket, kept as the theoretical arrival time of the
+ * generic cell rate algorithm, so that one compare and swap both refills and
+ * takes a token. Statements which suppressed messages are listed once, so
+ * that LoggingSystem::flush() can report the repeats nobody reported yet.
+ * Constant initialized, so a static instance costs no guard.
+ */
+class LogRateLimit
+{
+    DISABLE_COPY(LogRateLimit);
+    DISABLE_MOVE(LogRateLimit);
+
+public:
+    enum class Kind
+    {
+        EveryN,
+        PerSecond
+    };
+
+    constexpr LogRateLimit(Kind kind, uint32_t count, int line, const SourceFileName &file, LogEntry::Type type)
+        : kind(kind),
+          count(count ? count : 1),
+          line(line),
+          file(file),
+          type(type)
+    {}
+
+    /* Returns true if the message is to be logged, after reporting the repeats suppressed before it. */
+    bool admit()
+    {
+        if(kind == Kind::EveryN)
+        {
+            const uint64_t hit = state.fetchAdd(1, std::memory_order_relaxed);
+            if(hit % count != 0)
+            {
+                return false;
+            }
+            if( (hit != 0) && (count > 1) )
+            {
+                report(count - 1);
+            }
+            return true;
+        }
+        return admitPerSecond();
+    }
+
+    /* Reports the repeats of all statements that suppressed messages since their last report. */
+    static void reportRepeats();
+
+private:
+    bool admitPerSecond();
+    void report(uint32_t repeats);
+
+    /** Returns microseconds of a clock that never goes backwards. It may be coarse, a few milliseconds are fine.
+        \addtogroup PlatformRequiresImplementation */
+    static uint64_t platformMicroseconds();
+
+    const Kind kind;
+    const uint32_t count;
+    const int line;
+    const SourceFileName &file;
+    const LogEntry::Type type;
+    Atomic<uint64_t> state{0};     // EveryN: the hits, PerSecond: the theoretical arrival time
+    Atomic<uint32_t> repeats{0};
+    Atomic<bool> isListed{false};
+    LogRateLimit *next = nullptr;
+};
+/// \endcond
+
+}
+
+#endif // SILICA_LOG_RATE_LIMIT_H
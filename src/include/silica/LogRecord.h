@@ -0,0 +1,59 @@
+#ifndef SILICA_LOG_RECORD_H
+#define SILICA_LOG_RECORD_H
+
+#include <stddef.h>
+#include <silica/LogEntry.h>
+#include <silica/Macros.h>
+
+namespace Silica
+{
+
+/** \brief LogRecord is a LogEntry on its way to the sinks, together with its text.
+
+The text is formatted on the first call of text(), and then shared by all sinks the entry is delivered to. It reads
+\code
+# W :   42 : SilicaArray.cpp : Index out of range
+\endcode
+and ends with a newline. The file name is padded to \ref SILICA_LOGENTRY_FILENAME_MAX_LENGTH characters. The structured fields of
+LOG_KV follow the message, as <tt>conn=3 bytes=512</tt>.
+
+\ingroup Logging
+*/
+class LogRecord
+{
+    DISABLE_COPY(LogRecord);
+    DISABLE_MOVE(LogRecord);
+
+public:
+    /** \brief The longest text(), including the newline but not the terminating null. */
+    static constexpr size_t textMaxLength = 40 + SILICA_LOGENTRY_FILENAME_MAX_LENGTH + SILICA_LOGENTRY_MESSAGE_MAX_LENGTH
+                                            + 8 * SILICA_LOGENTRY_FIELDS_MAX_SIZE;
+
+    explicit LogRecord(const LogEntry &entry);
+
+    const LogEntry &entry() const { return d.entry; }
+
+    /** \brief Returns the entry formatted as a line of text, formatting it if this is the first call. */
+    const char *text() const;
+
+    /** \brief Returns the length of text(). */
+    size_t textLength() const;
+
+    /** \brief Returns the character identifying \p type in the text, e.g. \c 'W' for a warning. */
+    static char indicatorOf(LogEntry::Type type);
+
+private:
+    void format() const;
+
+    struct
+    {
+        const LogEntry &entry;
+        mutable bool isFormatted = false;
+        mutable size_t textLength = 0;
+        mutable char text[textMaxLength + 1];
+    } d;
+};
+
+}
+
+#endif // SILICA_LOG_RECORD_H
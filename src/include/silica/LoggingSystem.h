@@ -1,28 +1,78 @@
 #ifndef SILICA_LOGGING_SYSTEM_H
 #define SILICA_LOGGING_SYSTEM_H
 
+#include <silica/Atomic.h>
 #include <silica/LogEntry.h>
+#include <silica/LogRecord.h>
+#include <silica/Macros.h>
+#include <silica/Mutex.h>
+#include <stdint.h>
 
-#define LOG(formatString, ...) \
-{ \
-        Silica::LogEntry le(__LINE__, __FILE__);          \
-        le.format(formatString, ##__VA_ARGS__);           \
-        le.setType(Silica::LogEntry::Type::Log); \
-        Silica::LoggingSystem::instance()->sinkEntry(le); \
-}
+#ifndef SILICA_LOGGING_QUEUE_CAPACITY
+    /*! The number of entries the staging buffer of each logging thread holds in the asynchronous logging backend. Must be a power of two. See Silica::LoggingSystem::startAsynchronous(). */
+    #define SILICA_LOGGING_QUEUE_CAPACITY 256
+#endif
+
+#ifndef SILICA_LOGGING_MAX_SINKS
+    /*! The number of sinks Silica::LoggingSystem::addSink() can hold. */
+    #define SILICA_LOGGING_MAX_SINKS 4
+#endif
 
+#ifndef SILICA_LOG_MINIMUM_LEVEL
+    /*! Log statements below this level, e.g. \ref SILICA_LOG_LEVEL_DEBUG, are removed at compile time: their arguments are
+    not evaluated and no code is generated for them. FATAL is never removed. */
+    #define SILICA_LOG_MINIMUM_LEVEL SILICA_LOG_LEVEL_TRACE
+#endif
 
-#define WARN(formatString, ...) \
+#ifndef SILICA_LOG_DEFAULT_LEVEL
+    /*! The runtime threshold of Silica::LoggingSystem until changed with Silica::LoggingSystem::setLevel(). */
+    #define SILICA_LOG_DEFAULT_LEVEL SILICA_LOG_LEVEL_INFO
+#endif
+
+#ifndef SILICA_LOG_LEVEL_RULES
+    /*! The number of per file or per category thresholds Silica::LoggingSystem::setLevel() can hold. */
+    #define SILICA_LOG_LEVEL_RULES 16
+#endif
+
+static_assert(SILICA_LOG_MINIMUM_LEVEL <= SILICA_LOG_LEVEL_FATAL, "FATAL can not be removed");
+
+/// \cond DEVELOPER_DOC
+#define SILICA_LOG_ENTRY(entryType, category, formatString, ...) \
 { \
-        Silica::LogEntry le(__LINE__, __FILE__);          \
-        le.format(formatString, ##__VA_ARGS__);           \
-        le.setType(Silica::LogEntry::Type::Warning); \
-        Silica::LoggingSystem::instance()->sinkEntry(le); \
+    if constexpr (static_cast<int>(entryType) >= SILICA_LOG_MINIMUM_LEVEL) \
+    { \
+        static Silica::LogLevelFilter silicaLogFilter(__FILE__, category, entryType); \
+        if(silicaLogFilter.isEnabled()) \
+        { \
+            Silica::LogEntry le(__LINE__, SILICA_SOURCE_FILE_NAME); \
+            le.format(formatString, ##__VA_ARGS__);           \
+            le.setType(entryType); \
+            Silica::LoggingSystem::instance()->sinkEntry(le); \
+        } \
+    } \
 }
+/// \endcond
+
+/** Logs a detailed trace message. Disabled at runtime unless enabled with Silica::LoggingSystem::setLevel(). */
+#define LOG_TRACE(formatString, ...) SILICA_LOG_ENTRY(Silica::LogEntry::Type::Trace, nullptr, formatString, ##__VA_ARGS__)
+
+/** Logs a debug message. Disabled at runtime unless enabled with Silica::LoggingSystem::setLevel(). */
+#define LOG_DEBUG(formatString, ...) SILICA_LOG_ENTRY(Silica::LogEntry::Type::Debug, nullptr, formatString, ##__VA_ARGS__)
+
+/** Logs an informational message, the same as LOG. */
+#define LOG_INFO(formatString, ...) SILICA_LOG_ENTRY(Silica::LogEntry::Type::Info, nullptr, formatString, ##__VA_ARGS__)
+
+/** Logs a message of level \p entryType, a Silica::LogEntry::Type, in \p category. Runtime thresholds set for \p category apply to
+ *  it, instead of those of the file. \p category must be a string literal. */
+#define LOG_CATEGORY(category, entryType, formatString, ...) SILICA_LOG_ENTRY(entryType, category, formatString, ##__VA_ARGS__)
+
+#define LOG(formatString, ...) SILICA_LOG_ENTRY(Silica::LogEntry::Type::Log, nullptr, formatString, ##__VA_ARGS__)
+
+#define WARN(formatString, ...) SILICA_LOG_ENTRY(Silica::LogEntry::Type::Warning, nullptr, formatString, ##__VA_ARGS__)
 
 #define FATAL(formatString, ...) \
 { \
-        Silica::LogEntry le(__LINE__, __FILE__);          \
+        Silica::LogEntry le(__LINE__, SILICA_SOURCE_FILE_NAME); \
         le.format(formatString, ##__VA_ARGS__);           \
         le.setType(Silica::LogEntry::Type::Fatal); \
         Silica::LoggingSystem::instance()->sinkEntry(le); \
@@ -31,27 +81,231 @@
 namespace Silica
 {
 
+/** \brief LogSink is a destination of log entries, e.g. the console or a file.
+
+A sink implements either sinkEntry(), to receive the bare LogEntry, or sinkRecord(), to also receive the text all sinks share.
+
+Each sink filters entries by its own level(), and decides with flushInterval() how often it is flushed.
+
+\ingroup Logging
+*/
 class LogSink
 {
 public:
-    virtual void sinkEntry(const LogEntry &entry) = 0;
+    virtual ~LogSink() = default;
+
+    /** \brief Receives an entry of at least level(). */
+    virtual void sinkEntry(const LogEntry &) {}
+
+    /** \brief Receives an entry of at least level(), together with its text. Calls sinkEntry() unless overridden. */
+    virtual void sinkRecord(const LogRecord &record) { sinkEntry(record.entry()); }
+
+    /** \brief Writes out whatever the sink buffered. When this happens depends on flushInterval(). */
+    virtual void flush() {}
+
+    /** \brief Sets the least severe level this sink receives. By default, it receives all entries passing the thresholds of the
+     *  LoggingSystem. */
+    void setLevel(LogEntry::Type minimum) { d.level = minimum; }
+    LogEntry::Type level() const { return d.level; }
+
+    /** \brief Sets after how many entries the sink is flushed. 0, the default, flushes after every batch: after every entry in
+     *  synchronous mode, and after every batch of the writer thread in asynchronous mode. Whatever the interval, LoggingSystem::flush()
+     *  and FATAL flush all sinks. */
+    void setFlushInterval(size_t entries) { d.flushInterval = entries; }
+    size_t flushInterval() const { return d.flushInterval; }
+
+    /** \brief Makes the sink receive every entry on the thread that logged it, even while the asynchronous backend runs, instead of
+     *  after the entry went through the staging buffers and the writer thread. Staged entries are lost in a crash, so sinks meant to
+     *  survive one, like FlightRecorderLogSink, are synchronous.
+     *
+     *  A synchronous sink must be thread safe, as threads logging at the same time call it at the same time. While the backend is
+     *  asynchronous, it is only flushed by LoggingSystem::flush() and FATAL. Set it before adding the sink. */
+    void setSynchronous(bool isSynchronous) { d.isSynchronous = isSynchronous; }
+    bool isSynchronous() const { return d.isSynchronous; }
+
+private:
+    friend class LoggingSystem;
+    struct
+    {
+        LogEntry::Type level = LogEntry::Type::Trace;
+        size_t flushInterval = 0;
+        size_t pendingEntries = 0;
+        bool isSynchronous = false;
+    } d;
 };
 
+/// \cond DEVELOPER_DOC
+class AsynchronousLogWriter;
+
+/*
+ * The runtime filter of one log statement. It caches whether the statement
+ * passes the thresholds, and looks them up again only after setLevel() or
+ * clearLevels() changed the generation. Constant initialized, so a static
+ * instance costs no guard.
+ */
+class LogLevelFilter
+{
+    DISABLE_COPY(LogLevelFilter);
+    DISABLE_MOVE(LogLevelFilter);
+
+public:
+    constexpr LogLevelFilter(const char *file, const char *category, LogEntry::Type type)
+        : file(file),
+          category(category),
+          type(type)
+    {}
 
+    bool isEnabled()
+    {
+        const uint32_t generation = currentGeneration.load(std::memory_order_acquire);
+        const uint32_t cached = state.load(std::memory_order_relaxed);
+        if( (cached >> 1) == generation )
+        {
+            return cached & 1;
+        }
+        return refresh(generation);
+    }
+
+    static Atomic<uint32_t> currentGeneration;
+
+private:
+    bool refresh(uint32_t generation);
+
+    const char *file;
+    const char *category;
+    LogEntry::Type type;
+    Atomic<uint32_t> state{0};     // generation << 1 | isEnabled
+};
+/// \endcond
+
+/** \brief LoggingSystem delivers the entries of LOG, WARN and FATAL to the [LogSinks](\ref LogSink).
+
+Up to \ref SILICA_LOGGING_MAX_SINKS sinks receive each entry, newest first, so that the default sink, which terminates the program on
+FATAL, comes last. Every entry is wrapped into one LogRecord, whose text is formatted at most once, however many sinks use it.
+
+By default, every entry is delivered on the thread that logged it, and a mutex keeps threads logging at the same time from entering
+the sinks together. On operating systems, startAsynchronous() moves the delivery to a background thread: logging then only copies the
+LogEntry into a staging buffer of \ref SILICA_LOGGING_QUEUE_CAPACITY entries owned by the logging thread, so that logging threads never
+contend with each other. The writer thread collects the entries of all buffers, merges them in the order of their
+[timestamps](\ref LogEntry::timestamp()), and hands them to the sinks in batches.
+
+When the buffer of a thread is full, the QueuePolicy decides whether the entry is dropped or the logging thread waits for room. Dropped
+entries are counted, and reported by the writer thread with a warning of its own.
+
+FATAL entries are never queued: they first flush() the staging buffers, and are then delivered on the thread that logged them, so nothing logged
+before is lost when the sink terminates the program. [Synchronous sinks](\ref LogSink::setSynchronous()) bypass the staging buffers
+altogether, and receive every entry on the logging thread.
+
+\ingroup Logging
+*/
 class LoggingSystem
 {
 
 public:
+    /** \brief What logging does when the staging buffer of the logging thread is full. */
+    enum class QueuePolicy
+    {
+        Drop,   ///< The entry is discarded and counted, see droppedEntries().
+        Block   ///< The logging thread waits until the writer thread made room.
+    };
+
     static LoggingSystem* instance();
+
+    /** \brief Replaces all sinks by \p sink, or removes them if \p sink is null. Must not be called while the asynchronous backend is
+     *  running, neither may addSink() and removeSink(). */
     void setSink(LogSink *sink);
+
+    /** \brief Adds \p sink, which then receives entries before the sinks added earlier.
+     *  \returns False if \ref SILICA_LOGGING_MAX_SINKS sinks are already added, or \p sink is. */
+    bool addSink(LogSink *sink);
+
+    /** \brief Removes \p sink, after flushing it. */
+    void removeSink(LogSink *sink);
+
     void sinkEntry(const LogEntry &entry);
 
+    /** \brief Returns once all entries logged before the call were handed to the sinks, and the sinks were flushed. Reports the
+     *  repeats rate limited statements suppressed first, see LOG_RATE_LIMITED. */
+    void flush();
+
+    /** \brief Sets the runtime threshold of all log statements without a threshold of their own. Statements below \p minimum
+     *  cost a load and a compare, and are neither formatted nor delivered. FATAL is always delivered. */
+    void setLevel(LogEntry::Type minimum);
+
+    /** \brief Sets the runtime threshold of the log statements in category \p name, or, if they have no category, in the source file
+     *  named \p name, e.g. \c "SilicaArray.cpp". \p name must outlive the LoggingSystem, e.g. be a string literal.
+     *  \returns False if all \ref SILICA_LOG_LEVEL_RULES thresholds are taken. */
+    bool setLevel(const char *name, LogEntry::Type minimum);
+
+    /** \brief Removes all thresholds set with setLevel(const char*, LogEntry::Type). */
+    void clearLevels();
+
+    /** \brief Returns the runtime threshold of statements in \p file, or in \p category if not null. */
+    LogEntry::Type level(const char *file, const char *category = nullptr);
+
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+    /** \brief Starts the writer thread, after which entries are delivered asynchronously. The writer thread is stopped when the
+     *  program exits.
+     *  \returns False if the asynchronous backend is already running. */
+    bool startAsynchronous(QueuePolicy policy = QueuePolicy::Drop);
+
+    /** \brief Delivers the entries still queued, stops the writer thread and returns to synchronous delivery.
+     *  Entries logged by other threads while stopping may remain queued until the backend is started again. */
+    void stopAsynchronous();
+
+    /** \brief Returns true while the asynchronous backend is running. */
+    bool isAsynchronous() const;
+
+    /** \brief Returns the number of entries dropped because a staging buffer was full, since the program started. */
+    uint64_t droppedEntries() const;
+#endif
+
 private:
     LoggingSystem();
     ~LoggingSystem();
+
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+    /// \cond DEVELOPER_DOC
+    friend class AsynchronousLogWriter;
+    bool enqueue(const LogEntry &entry);
+    bool waitForWriter();
+    // Hands an entry about to be staged to the synchronous sinks, on the logging thread and without locking.
+    void deliverToSynchronousSinks(const LogEntry &entry);
+    /// \endcond
+#endif
+
+    /// \cond DEVELOPER_DOC
+    // isStaged skips the synchronous sinks, which got the entry when it was staged.
+    void deliver(const LogEntry &entry, bool isStaged = false);
+    void endBatch();
+    void flushSinks();
+
+    /* Serializes the delivery to the sinks. Returns false without locking if the calling thread is delivering already, e.g. when a
+       sink logs. */
+    bool lockDelivery();
+    void unlockDelivery();
+    /// \endcond
+
+    /// \cond DEVELOPER_DOC
+    struct LevelRule
+    {
+        const char *name = nullptr;
+        LogEntry::Type minimum = LogEntry::Type::Log;
+    };
+    /// \endcond
+
     struct
     {
-        LogSink *sink = nullptr;
+        LogSink *sinks[SILICA_LOGGING_MAX_SINKS] = {};
+        size_t sinkCount = 0;
+        LogEntry::Type defaultLevel = static_cast<LogEntry::Type>(SILICA_LOG_DEFAULT_LEVEL);
+        LevelRule levelRules[SILICA_LOG_LEVEL_RULES];
+        size_t levelRuleCount = 0;
+        Mutex levelMutex{"LoggingSystem::levelMutex"};
+        Mutex deliveryMutex{"LoggingSystem::deliveryMutex"};
+#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
+        Atomic<AsynchronousLogWriter*> writer{nullptr};
+#endif
     } d;
 
 
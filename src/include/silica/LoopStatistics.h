@@ -0,0 +1,188 @@
+#ifndef SILICA_LOOP_STATISTICS_H
+#define SILICA_LOOP_STATISTICS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef SILICA_ENABLE_LOOP_INSTRUMENTATION
+#include <silica/Atomic.h>
+#endif
+
+#ifndef SILICA_LOOP_HISTOGRAM_BUCKETS
+    /*! The number of buckets in the duration histograms of Silica::DurationStatistics. Bucket 0 counts durations below 1 microsecond,
+    bucket \c i counts durations from 2^(i-1) up to 2^i microseconds, and the last bucket counts everything longer. */
+    #define SILICA_LOOP_HISTOGRAM_BUCKETS 24
+#endif
+
+#ifndef SILICA_LOOP_STALL_THRESHOLD
+    /*! A pass of the event loop taking longer than this many microseconds is counted as a stall in Silica::LoopStatistics. */
+    #define SILICA_LOOP_STALL_THRESHOLD 10000
+#endif
+
+#ifdef DOXYGEN
+    /*! Enables measuring the duration of every EventGenerator::visit() and every pass of the event loop. Read the measurements with
+    Silica::EventGenerator::visitStatistics() and Silica::Application::loopStatistics().
+
+    By default, the instrumentation is disabled, takes up no space and does not read the clock. The macro changes the layout of
+    EventGenerator and Application, so it must be the same in every translation unit of a program. Turn on the CMake option of the
+    same name instead of defining it in a source file.
+    */
+#define SILICA_ENABLE_LOOP_INSTRUMENTATION
+#endif
+
+namespace Silica
+{
+
+/** \brief DurationStatistics is a snapshot of how often something ran and for how long.
+
+\ingroup Core
+*/
+struct DurationStatistics
+{
+    /** The number of durations recorded. */
+    uint64_t count = 0;
+    /** The sum of the durations recorded, in microseconds. */
+    uint64_t totalMicroseconds = 0;
+    /** The longest duration recorded, in microseconds. */
+    uint64_t maxMicroseconds = 0;
+    /** The number of durations per power of two microseconds. See \ref SILICA_LOOP_HISTOGRAM_BUCKETS. */
+    uint64_t histogram[SILICA_LOOP_HISTOGRAM_BUCKETS] = {};
+
+    /** Returns the mean duration in microseconds, or 0 if nothing was recorded. */
+    uint64_t averageMicroseconds() const { return count ? totalMicroseconds / count : 0; }
+};
+
+/** \brief LoopStatistics is a snapshot of the measurements of the event loop. See Application::loopStatistics().
+
+\ingroup Core
+*/
+struct LoopStatistics
+{
+    /** The duration of the passes of the event loop that had work to do. The time spent sleeping is not included. */
+    DurationStatistics passes;
+    /** The number of passes that took longer than \ref SILICA_LOOP_STALL_THRESHOLD microseconds. */
+    uint64_t stalls = 0;
+};
+
+/// \cond DEVELOPER_DOC
+
+#ifdef SILICA_ENABLE_LOOP_INSTRUMENTATION
+constexpr bool loopInstrumentationEnabled = true;
+
+/*
+ * Only the loop thread records, so plain loads and stores are enough, and
+ * other threads can take a snapshot at any time. A snapshot taken during a
+ * recording may see some fields updated and others not.
+ */
+class DurationCounters
+{
+public:
+    void record(uint64_t microseconds)
+    {
+        increment(count);
+        total.store(total.load(std::memory_order_relaxed) + microseconds, std::memory_order_relaxed);
+        if(microseconds > max.load(std::memory_order_relaxed))
+        {
+            max.store(microseconds, std::memory_order_relaxed);
+        }
+        increment(histogram[bucketOf(microseconds)]);
+    }
+
+    void snapshot(DurationStatistics &result) const
+    {
+        result.count = count.load(std::memory_order_relaxed);
+        result.totalMicroseconds = total.load(std::memory_order_relaxed);
+        result.maxMicroseconds = max.load(std::memory_order_relaxed);
+        for(size_t i = 0; i < SILICA_LOOP_HISTOGRAM_BUCKETS; i++)
+        {
+            result.histogram[i] = histogram[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    void reset()
+    {
+        count.store(0, std::memory_order_relaxed);
+        total.store(0, std::memory_order_relaxed);
+        max.store(0, std::memory_order_relaxed);
+        for(Atomic<uint64_t> &bucket : histogram)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    static size_t bucketOf(uint64_t microseconds)
+    {
+        size_t bucket = 0;
+        while(microseconds > 0 && bucket < SILICA_LOOP_HISTOGRAM_BUCKETS - 1)
+        {
+            microseconds >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+protected:
+    static void increment(Atomic<uint64_t> &counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+private:
+    Atomic<uint64_t> count{0};
+    Atomic<uint64_t> total{0};
+    Atomic<uint64_t> max{0};
+    Atomic<uint64_t> histogram[SILICA_LOOP_HISTOGRAM_BUCKETS] = {};
+};
+
+class LoopCounters : public DurationCounters
+{
+public:
+    void record(uint64_t microseconds)
+    {
+        DurationCounters::record(microseconds);
+        if(microseconds > SILICA_LOOP_STALL_THRESHOLD)
+        {
+            increment(stalls);
+        }
+    }
+
+    void snapshot(LoopStatistics &result) const
+    {
+        DurationCounters::snapshot(result.passes);
+        result.stalls = stalls.load(std::memory_order_relaxed);
+    }
+
+    void reset()
+    {
+        DurationCounters::reset();
+        stalls.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    Atomic<uint64_t> stalls{0};
+};
+#else
+constexpr bool loopInstrumentationEnabled = false;
+
+class DurationCounters
+{
+public:
+    void record(uint64_t) {}
+    void snapshot(DurationStatistics &) const {}
+    void reset() {}
+};
+
+class LoopCounters
+{
+public:
+    void record(uint64_t) {}
+    void snapshot(LoopStatistics &) const {}
+    void reset() {}
+};
+#endif
+
+/// \endcond
+
+}
+
+#endif // SILICA_LOOP_STATISTICS_H
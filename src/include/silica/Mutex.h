@@ -1,21 +1,61 @@
-#include <silica/Macros.h>
+#ifndef SILICA_MUTEX_H
+#define SILICA_MUTEX_H
 
-#if \
-       defined(SILICA_OS_WINDOWS) \
-    || defined(SILICA_OS_LINUX) \
-    || defined(SILICA_OS_MACOS)
+#include <stddef.h>
+#include <stdint.h>
+#include <silica/Atomic.h>
+#include <silica/Macros.h>
 
-        #include <mutex>
+#ifndef SILICA_MUTEX_SPIN_COUNT
+    /*! The number of times a Silica::Mutex polls a held lock before the calling thread is parked in the operating system. Critical
+    sections shorter than the spinning are taken over without a system call. */
+    #define SILICA_MUTEX_SPIN_COUNT 100
 #endif
 
+#ifdef DOXYGEN
+    /*! Enables counting the acquisitions, contended acquisitions and waiting times of every Silica::Mutex. Read them with
+    Silica::Mutex::statistics(), or find the most contended Mutexes of the program with Silica::Mutex::mostContended().
 
+    By default, the counters are disabled, take up no space and the clock is never read. The macro changes the layout of Mutex, so it
+    must be the same in every translation unit of a program. Turn on the CMake option of the same name instead of defining it in a
+    source file.
+    */
+#define SILICA_ENABLE_MUTEX_STATISTICS
+#endif
 
 namespace Silica
 {
 
+/** \brief MutexStatistics is a snapshot of the counters of a Mutex. See Mutex::statistics().
+
+\ingroup Core
+*/
+struct MutexStatistics
+{
+    /** The name the Mutex was constructed with, or nullptr. */
+    const char *name = nullptr;
+    /** The number of times the Mutex was locked, including successful calls to Mutex::tryLock(). */
+    uint64_t acquisitions = 0;
+    /** The number of times a thread had to wait, because the Mutex was held by another thread. */
+    uint64_t contendedAcquisitions = 0;
+    /** The sum of the time threads waited for the Mutex, in nanoseconds. */
+    uint64_t totalWaitNanoseconds = 0;
+    /** The longest time a thread waited for the Mutex, in nanoseconds. */
+    uint64_t maxWaitNanoseconds = 0;
+};
 
 /** \brief Mutex provices a synchronization mechanism that can prevent simultaneously access to shared data.
 
+Mutex is adaptive: a thread finding it locked first spins for \ref SILICA_MUTEX_SPIN_COUNT polls, and is then parked in the operating
+system until the Mutex is unlocked. On Linux the parking is done on a futex, and unlock() only enters the kernel if a thread is parked.
+Locking and unlocking a Mutex nobody else holds is a single atomic operation each.
+
+On baremetal targets there is no thread to park, so a waiting lock() keeps polling until the Mutex is unlocked, e.g. from an interrupt
+handler.
+
+When built with \ref SILICA_ENABLE_MUTEX_STATISTICS, every Mutex counts how often it was locked, how often a thread had to wait for it,
+and for how long. Give the Mutexes of interest a name, and find those in need of a redesign with mostContended() or logMostContended().
+
 \ingroup Core
  */
 class Mutex
@@ -25,8 +65,9 @@ class Mutex
     DISABLE_MOVE(Mutex);
 
 public:
-    /** \brief Creates a new unlocked Mutex. */
-    Mutex();
+    /** \brief Creates a new unlocked Mutex.
+     *  \param name A name reported in the MutexStatistics of this Mutex. It is not copied and must outlive this Mutex. */
+    explicit Mutex(const char *name = nullptr);
     ~Mutex();
 
     /** \brief Locks this Mutex.
@@ -41,13 +82,52 @@ public:
      *  \returns True if this Mutex could be locked, false if not. */
     bool tryLock();
 
+    /** \brief Returns a snapshot of the counters of this Mutex.
+     *  The counters are only maintained when \ref SILICA_ENABLE_MUTEX_STATISTICS is defined. Otherwise, all values are 0.
+     *  Reading the statistics never blocks, a snapshot taken while the Mutex is locked may be slightly inconsistent. */
+    MutexStatistics statistics() const;
+
+    /** \brief Resets all counters of statistics() to 0. */
+    void resetStatistics();
+
+    /** \brief Writes the statistics of up to \p capacity Mutexes of the program to \p statistics, the ones threads waited for the longest
+     *  in total first. Mutexes nobody waited for are left out.
+     *  \returns The number of MutexStatistics written. Always 0 without \ref SILICA_ENABLE_MUTEX_STATISTICS. */
+    static size_t mostContended(MutexStatistics *statistics, size_t capacity);
+
+    /** \brief Logs the statistics of up to \p count, at most 16, of the most contended Mutexes, see mostContended(). */
+    static void logMostContended(size_t count = 10);
+
     /// \cond DEVELOPER_DOC
 private:
+    void lockContended();
+
+    /** Parks the calling thread while the state of this Mutex equals \p expected.
+        \addtogroup PlatformRequiresImplementation */
+    void platformWait(int32_t expected);
+
+    /** Wakes one thread parked in platformWait().
+        \addtogroup PlatformRequiresImplementation */
+    void platformWake();
+
+    /** Returns the time in nanoseconds on a clock that never goes backwards. Only called with \ref SILICA_ENABLE_MUTEX_STATISTICS.
+        \addtogroup PlatformRequiresImplementation */
+    static uint64_t platformNanoseconds();
 
     struct
     {
-#if defined(SILICA_OS_WINDOWS) || defined(SILICA_OS_LINUX) || defined(SILICA_OS_MACOS)
-        std::mutex mutex;
+        // 0: unlocked, 1: locked, 2: locked and threads may be parked
+        Atomic<int32_t> state{0};
+#ifdef SILICA_ENABLE_MUTEX_STATISTICS
+        const char *name = nullptr;
+        // Only written by the thread holding the Mutex, so plain loads and stores are enough.
+        Atomic<uint64_t> acquisitions{0};
+        Atomic<uint64_t> contendedAcquisitions{0};
+        Atomic<uint64_t> totalWaitNanoseconds{0};
+        Atomic<uint64_t> maxWaitNanoseconds{0};
+        // The registry of all Mutexes, for mostContended()
+        Mutex *previous = nullptr;
+        Mutex *next = nullptr;
 #endif
     } d;
     /// \endcond
@@ -84,3 +164,5 @@ private:
 };
 
 }
+
+#endif // SILICA_MUTEX_H
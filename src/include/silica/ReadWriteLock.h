@@ -0,0 +1,141 @@
+#ifndef SILICA_READ_WRITE_LOCK_H
+#define SILICA_READ_WRITE_LOCK_H
+
+#include <stdint.h>
+#include <silica/Atomic.h>
+#include <silica/Macros.h>
+
+#ifndef SILICA_READ_WRITE_LOCK_SPIN_COUNT
+    /*! The number of times a Silica::ReadWriteLock polls before the calling thread is parked in the operating system. */
+    #define SILICA_READ_WRITE_LOCK_SPIN_COUNT 100
+#endif
+
+namespace Silica
+{
+
+/** \brief ReadWriteLock lets any number of threads read shared data at once, or a single thread write it.
+
+Use it for data that is read much more often than it is written, e.g. configuration or routing tables. Readers only contend on the
+atomic counter of the lock, never on each other's critical sections. For small, trivially copyable data, a SeqLock scales better still,
+as its readers do not write to shared memory at all.
+
+Writers take precedence: once a writer waits, new readers wait, too, so that a steady stream of readers cannot starve the writers.
+Like Mutex, a waiting thread spins for \ref SILICA_READ_WRITE_LOCK_SPIN_COUNT polls and is then parked, on a futex on Linux. Unlocking
+only enters the kernel if a thread is parked. The lock is not recursive, and a reader cannot upgrade to a writer.
+
+\ingroup Core
+ */
+class ReadWriteLock
+{
+    DISABLE_COPY(ReadWriteLock);
+    DISABLE_MOVE(ReadWriteLock);
+
+public:
+    /** \brief Creates a new unlocked ReadWriteLock. */
+    ReadWriteLock();
+    ~ReadWriteLock();
+
+    /** \brief Locks for reading, blocking the calling thread while a writer holds the lock or waits for it. */
+    void lockForRead();
+
+    /** \brief Locks for reading without blocking.
+     *  \returns True if the lock was taken for reading, false if a writer holds the lock or waits for it. */
+    bool tryLockForRead();
+
+    /** \brief Releases a lock taken for reading. */
+    void unlockForRead();
+
+    /** \brief Locks for writing, blocking the calling thread until no reader or writer holds the lock. */
+    void lockForWrite();
+
+    /** \brief Locks for writing without blocking.
+     *  \returns True if the lock was taken for writing, false if a reader or writer holds it. */
+    bool tryLockForWrite();
+
+    /** \brief Releases a lock taken for writing. */
+    void unlockForWrite();
+
+    /// \cond DEVELOPER_DOC
+private:
+    void wakeWaiters();
+
+    /** Parks the calling thread while the state of this ReadWriteLock equals \p expected.
+        \addtogroup PlatformRequiresImplementation */
+    void platformWait(int32_t expected);
+
+    /** Wakes all threads parked in platformWait().
+        \addtogroup PlatformRequiresImplementation */
+    void platformWakeAll();
+
+    // The number of readers in the lower bits, and one bit each for a writer holding the lock and a writer waiting for it
+    static constexpr int32_t writerBit = int32_t(1) << 30;
+    static constexpr int32_t writerWaitingBit = int32_t(1) << 29;
+    static constexpr int32_t readersMask = writerWaitingBit - 1;
+
+    struct
+    {
+        Atomic<int32_t> state{0};
+        Atomic<int32_t> waiters{0};
+    } d;
+    /// \endcond
+};
+
+/** \brief ReadLocker locks a ReadWriteLock for reading, and unlocks it in its destructor.
+ * \ingroup Core
+ */
+class ReadLocker
+{
+    DISABLE_COPY(ReadLocker);
+    DISABLE_MOVE(ReadLocker);
+
+public:
+    /** \brief Locks \p target for reading, blocking until it could be locked. */
+    explicit ReadLocker(ReadWriteLock &target)
+        : target(target)
+    {
+        this->target.lockForRead();
+    }
+
+    /** \brief Releases the lock. */
+    ~ReadLocker()
+    {
+        target.unlockForRead();
+    }
+
+    /// \cond DEVELOPER_DOC
+private:
+    ReadWriteLock &target;
+    /// \endcond
+};
+
+/** \brief WriteLocker locks a ReadWriteLock for writing, and unlocks it in its destructor.
+ * \ingroup Core
+ */
+class WriteLocker
+{
+    DISABLE_COPY(WriteLocker);
+    DISABLE_MOVE(WriteLocker);
+
+public:
+    /** \brief Locks \p target for writing, blocking until it could be locked. */
+    explicit WriteLocker(ReadWriteLock &target)
+        : target(target)
+    {
+        this->target.lockForWrite();
+    }
+
+    /** \brief Releases the lock. */
+    ~WriteLocker()
+    {
+        target.unlockForWrite();
+    }
+
+    /// \cond DEVELOPER_DOC
+private:
+    ReadWriteLock &target;
+    /// \endcond
+};
+
+}
+
+#endif // SILICA_READ_WRITE_LOCK_H
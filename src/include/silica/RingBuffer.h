@@ -3,6 +3,12 @@
 
 #include <stdint.h>
 #include <silica/Array.h>
+#include <silica/Atomic.h>
+#include <silica/Macros.h>
+
+///@cond
+namespace Silica {  template <typename T, size_t S = 0> class RingBuffer; }
+///@endcond
 
 namespace Silica
 {
@@ -30,7 +36,119 @@ enum class OverflowPolicy
 
 
 /**
- * \brief RingBuffer implements a ring buffer for S elements of type T.
+ * \brief RingBufferStatistics is a snapshot of the counters maintained by a RingBuffer.
+ *
+ * \see RingBuffer::statistics()
+ */
+struct RingBufferStatistics
+{
+    /** The number of calls to RingBuffer::push(), including the ones that were dropped. */
+    size_t pushes = 0;
+
+    /** The number of elements that were discarded under OverflowPolicy::SkipNewData. */
+    size_t drops = 0;
+
+    /** The number of elements that were overwritten under OverflowPolicy::OverwriteOldestData. */
+    size_t overwrites = 0;
+
+    /** The highest number of elements held at once since construction or the last reset. */
+    size_t highWaterMark = 0;
+};
+
+
+///@cond
+#ifdef SILICA_ENABLE_RINGBUFFER_STATISTICS
+/*
+ * Only the pushing thread writes the counters, so plain loads and stores are
+ * enough, and other threads can read them at any time.
+ */
+class RingBufferStatisticsCounters
+{
+public:
+    void countPush() { increment(pushes); }
+    void countDrop() { increment(drops); }
+    void countOverwrite() { increment(overwrites); }
+
+    void updateHighWaterMark(size_t size)
+    {
+        if(size > highWaterMark.load(std::memory_order_relaxed))
+        {
+            highWaterMark.store(size, std::memory_order_relaxed);
+        }
+    }
+
+    RingBufferStatistics snapshot() const
+    {
+        RingBufferStatistics result;
+        result.pushes = pushes.load(std::memory_order_relaxed);
+        result.drops = drops.load(std::memory_order_relaxed);
+        result.overwrites = overwrites.load(std::memory_order_relaxed);
+        result.highWaterMark = highWaterMark.load(std::memory_order_relaxed);
+        return result;
+    }
+
+    void reset(size_t currentSize)
+    {
+        pushes.store(0, std::memory_order_relaxed);
+        drops.store(0, std::memory_order_relaxed);
+        overwrites.store(0, std::memory_order_relaxed);
+        highWaterMark.store(currentSize, std::memory_order_relaxed);
+    }
+
+private:
+    static void increment(Atomic<size_t> &counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    Atomic<size_t> pushes{0};
+    Atomic<size_t> drops{0};
+    Atomic<size_t> overwrites{0};
+    Atomic<size_t> highWaterMark{0};
+};
+#else
+class RingBufferStatisticsCounters
+{
+public:
+    void countPush() {}
+    void countDrop() {}
+    void countOverwrite() {}
+    void updateHighWaterMark(size_t) {}
+    RingBufferStatistics snapshot() const { return RingBufferStatistics(); }
+    void reset(size_t) {}
+};
+#endif
+///@endcond
+
+
+/**
+ * \brief RingBuffer implements a ring buffer for S elements of type T. RingBuffer may have static or dynamic capacity.
+
+Regarding capacity, RingBuffer<T,S> follows the \ref Dual_Capacity_Policies "dual capacity policy" of the other containers:
+
+<table>
+<tr>
+    <th>\c S</th>
+    <th>Behaviour</th>
+</tr>
+<tr>
+    <td><code>S > 0</code></td>
+    <td>
+        The RingBuffer has a fixed capacity of \c S elements and will never grow nor shrink.<br/>
+        With <code>S > 0</code>, RingBuffer<T,S> is guaranteed to not perform any dynamic allocations.
+    </td>
+</tr>
+<tr>
+    <td><code>S = 0</code></td>
+    <td>
+        The RingBuffer has a dynamic capacity and doubles it when full.<br/>
+        With \c S \c = \c 0, RingBuffer<T,S> allocates \ref SILICA_ARRAY_INITIAL_CAPACITY elements upon instantiation. When growing, the content
+        is relinearized into the new storage in a single pass, so the oldest element ends up first.<br/>
+        An optional upper bound may be set using \c setMaximumCapacity(). Once the capacity has reached that bound, the
+        buffer no longer grows and the \ref overflow_section "OverflowPolicy" applies just like for static RingBuffers.
+    </td>
+</tr>
+</table>
 
 ### Examples
 
@@ -77,9 +195,24 @@ int main(int argc, char *argv[])
 
 ## Thread Safety
 
-RingBuffer is thread safe iff you use the OverflowPolicy::SkipNewData policy.
-Inder this condition, only the thread calling push() will update tehe tail and only the
-thread calling peek() and pop().
+RingBuffer is thread safe iff you use the OverflowPolicy::SkipNewData policy, with a single thread calling push() and a single thread
+calling peek() and pop(). Under this condition, only the pushing thread updates the tail and only the popping thread updates the head.
+Both indices are Atomic, the tail is published with release semantics after the element is written, and the head after the element is
+cleared, so the other side never sees an index ahead of the element. This holds just as well for main code sharing a RingBuffer with an
+interrupt handler, on every target.
+
+\note RingBuffers with dynamic capacity (\c S \c = \c 0) are not thread safe, as growing replaces the storage from under a concurrent reader.
+
+\anchor statistics_section
+## Statistics
+
+When built with \ref SILICA_ENABLE_RINGBUFFER_STATISTICS defined, every RingBuffer counts the number of pushes, the number of elements
+dropped under OverflowPolicy::SkipNewData, the number of elements overwritten under OverflowPolicy::OverwriteOldestData and the highest
+number of elements held at once. The counters are read with statistics() without any locking, and are meant for sizing buffers from
+production data.
+
+Without \ref SILICA_ENABLE_RINGBUFFER_STATISTICS, the counters take up no space and cost nothing on the push path. As the macro changes
+the layout of RingBuffer, it is set program wide with the CMake option \c SILICA_ENABLE_RINGBUFFER_STATISTICS.
 
 \anchor overflow_section
 ## Overflows
@@ -183,17 +316,29 @@ public:
     \see The section on \link overflow_section overflow \endlink. */
     void  setOverflowPolicy(OverflowPolicy newPolicy) { d.overflowPolicy = newPolicy; }
 
+    /** \brief Returns a snapshot of the push and overflow counters of this RingBuffer.
+    The counters are only maintained when \ref SILICA_ENABLE_RINGBUFFER_STATISTICS is defined. Otherwise, all values are 0.
+    Reading the statistics never blocks and may be done from any thread.
+    \returns A snapshot of the counters since construction or the last call to resetStatistics().
+    \see The section on \link statistics_section statistics \endlink. */
+    RingBufferStatistics statistics() const { return d.statistics.snapshot(); }
+
+    /** \brief Resets all counters of statistics() to 0.
+    The high-water mark is reset to the current size. */
+    void resetStatistics() { d.statistics.reset(size()); }
+
 //private:
 ///@cond
 
-    SILICA_VOLATILE struct
+    struct
     {
         void (*overflowCallback)(const RingBuffer &, size_t currentHeadIndex, size_t currentTailIndex, const T& element) = nullptr;
         Array<T, S+1> data;
-        size_t headIndex = 0;
-        size_t tailIndex = 0;
+        Atomic<size_t> headIndex{0};    // Written by the popping side, or by push() when overwriting
+        Atomic<size_t> tailIndex{0};    // Written by the pushing side
         const size_t Capacity = S + 1;
         OverflowPolicy overflowPolicy = OverflowPolicy::OverwriteOldestData;
+        [[no_unique_address]] RingBufferStatisticsCounters statistics;
     } d;
 ///@endcond
 };
@@ -214,39 +359,48 @@ RingBuffer<T,S>::~RingBuffer()
 template <typename T, size_t S>
 bool RingBuffer<T,S>::push(const T &element)
 {
-    size_t next = (d.tailIndex + 1) % d.Capacity;
-    size_t nextHeadIndex = d.headIndex;
-    if (next == d.headIndex) {
+    d.statistics.countPush();
+    const size_t tailIndex = d.tailIndex.load(std::memory_order_relaxed);
+    const size_t headIndex = d.headIndex.load(std::memory_order_acquire);
+    size_t next = (tailIndex + 1) % d.Capacity;
+    size_t nextHeadIndex = headIndex;
+    if (next == headIndex) {
         if (d.overflowPolicy == OverflowPolicy::SkipNewData)
         {
+            d.statistics.countDrop();
             if(d.overflowCallback)
             {
-                d.overflowCallback(*this, d.headIndex, d.tailIndex, element);
+                d.overflowCallback(*this, headIndex, tailIndex, element);
             }
             return false;
         }
         else if (d.overflowPolicy == OverflowPolicy::OverwriteOldestData)
         {
+            d.statistics.countOverwrite();
             if(d.overflowCallback)
             {
-                d.overflowCallback(*this, d.headIndex, d.tailIndex, element);
+                d.overflowCallback(*this, headIndex, tailIndex, element);
             }
-            nextHeadIndex = (d.headIndex + 1) % d.Capacity;
+            nextHeadIndex = (headIndex + 1) % d.Capacity;
         }
     }
 
 
     try
     {
-        d.data[d.tailIndex] = element;
-        d.tailIndex = (d.tailIndex + 1) % d.Capacity;
-        d.headIndex = nextHeadIndex;
+        d.data[tailIndex] = element;
+        d.tailIndex.store(next, std::memory_order_release);
+        if(nextHeadIndex != headIndex)
+        {
+            d.headIndex.store(nextHeadIndex, std::memory_order_release);
+        }
     }
     catch(...)
     {
         //Do not update change the buffer. The element is now in undefined state.
         throw;
     }
+    d.statistics.updateHighWaterMark(size());
 
 
     return true;
@@ -257,27 +411,29 @@ bool RingBuffer<T,S>::push(const T &element)
 template <typename T, size_t S>
 const T &RingBuffer<T,S>::peek() const
 {
-    if (d.headIndex == d.tailIndex) {
+    const size_t headIndex = d.headIndex.load(std::memory_order_relaxed);
+    if (headIndex == d.tailIndex.load(std::memory_order_acquire)) {
         return d.data[S+1]; //This is the 'default' element. Garbage.
     }
-    return d.data[d.headIndex];
+    return d.data[headIndex];
 }
 
 template <typename T, size_t S>
 bool RingBuffer<T,S>::pop()
 {
-    if (d.headIndex == d.tailIndex)
+    const size_t headIndex = d.headIndex.load(std::memory_order_relaxed);
+    if (headIndex == d.tailIndex.load(std::memory_order_acquire))
     {
         return false; // buffer is empty
     }
     try
     {
-        d.data[d.headIndex] = T();
-        d.headIndex = (d.headIndex+ 1) % d.Capacity;
+        d.data[headIndex] = T();
+        d.headIndex.store((headIndex + 1) % d.Capacity, std::memory_order_release);
     }
     catch (...)
     {
-        d.headIndex = (d.headIndex+ 1) % d.Capacity;
+        d.headIndex.store((headIndex + 1) % d.Capacity, std::memory_order_release);
         throw;
     }
     return true;
@@ -287,7 +443,8 @@ bool RingBuffer<T,S>::pop()
 template <typename T, size_t S>
 size_t RingBuffer<T,S>::size() const
 {
-    return (d.tailIndex + d.Capacity - d.headIndex) % d.Capacity;
+    const size_t headIndex = d.headIndex.load(std::memory_order_acquire);
+    return (d.tailIndex.load(std::memory_order_acquire) + d.Capacity - headIndex) % d.Capacity;
 }
 
 template <typename T, size_t S>
@@ -315,6 +472,253 @@ void RingBuffer<T,S>::setOverRunCallBack(void (*overRunCallback)(const RingBuffe
 
 
 
+namespace Silica
+{
+
+///@cond
+template <typename T>
+class RingBuffer<T, 0>
+{
+    DISABLE_COPY(RingBuffer);
+    DISABLE_MOVE(RingBuffer);
+
+public:
+
+    /** \brief Creates an empty RingBuffer with dynamic capacity.
+    The initial capacity is \ref SILICA_ARRAY_INITIAL_CAPACITY and no maximum capacity is set.
+     */
+    RingBuffer();
+
+    /** \brief Cleans up a RingBuffer and releases its storage. */
+    virtual ~RingBuffer();
+
+    /** \brief Pushes a T onto the end of the ringbuffer, growing the capacity if needed and allowed.
+    If the RingBuffer is full and the capacity has reached the maximum capacity, the OverflowPolicy applies.
+    \throws Anything Any exception thrown in \c T& \c operator=(const T &other) is rethrown after proper bookkeeping.
+    */
+    bool push(const T &element);
+
+    /** \brief Returns a reference to the firstmost element in the buffer or a reference to a garbage element if empty. */
+    const T &peek() const;
+
+    /** \brief Deletes the first elemenet in the buffer promoting next element to the head.
+    \returns True if an element was popped and false if the RungBuffer is empty an nothing could be popped.
+    */
+    bool pop();
+
+    /** \brief Returns the number of T instances currently in the RingBuffer. */
+    size_t size() const;
+
+    /** \brief Returns the number of T instances this Ringbuffer can currently have pushed before having to grow. */
+    size_t sizeAvailable() const;
+
+    /** \brief Returns the current capacity of this RingBuffer instance. */
+    size_t capacity() const;
+
+    /** \brief Returns the maximum capacity this RingBuffer may grow to. 0 means unbounded. */
+    size_t maximumCapacity() const { return d.maximumCapacity; }
+
+    /** \brief Sets the maximum capacity this RingBuffer may grow to.
+
+    Growing is stopped at \p maximumCapacity, and any further overflow is handled according to the OverflowPolicy.
+    \param maximumCapacity The new maximum capacity. 0 means unbounded, which is the default.
+    \note The RingBuffer never shrinks. If the current capacity is already above \p maximumCapacity, the current capacity is kept.
+    */
+    void setMaximumCapacity(size_t maximumCapacity) { d.maximumCapacity = maximumCapacity; }
+
+    void setOverRunCallBack(void (*overRunCallback)(const RingBuffer & buffer, size_t currentHeadIndex, size_t currentTailIndex, const T& element));
+
+    OverflowPolicy overflowPolicy() const { return d.overflowPolicy;}
+
+    void  setOverflowPolicy(OverflowPolicy newPolicy) { d.overflowPolicy = newPolicy; }
+
+    RingBufferStatistics statistics() const { return d.statistics.snapshot(); }
+
+    void resetStatistics() { d.statistics.reset(size()); }
+
+    struct
+    {
+        void (*overflowCallback)(const RingBuffer &, size_t currentHeadIndex, size_t currentTailIndex, const T& element) = nullptr;
+        T *data = nullptr;
+        size_t headIndex = 0;
+        size_t tailIndex = 0;
+        size_t Capacity = 0;
+        size_t maximumCapacity = 0;
+        OverflowPolicy overflowPolicy = OverflowPolicy::OverwriteOldestData;
+        [[no_unique_address]] RingBufferStatisticsCounters statistics;
+        T outOfBoundElement = {};
+    } d;
+
+private:
+    bool mayGrow() const;
+    void growCapacity();
+};
+
+
+template <typename T>
+RingBuffer<T,0>::RingBuffer()
+{
+    d.Capacity = SILICA_ARRAY_INITIAL_CAPACITY + 1;
+    d.data = new T[d.Capacity];
+}
+
+template <typename T>
+RingBuffer<T,0>::~RingBuffer()
+{
+    delete [] d.data;
+}
+
+template <typename T>
+bool RingBuffer<T,0>::mayGrow() const
+{
+    return (d.maximumCapacity == 0) || (capacity() < d.maximumCapacity);
+}
+
+template <typename T>
+void RingBuffer<T,0>::growCapacity()
+{
+    size_t newCapacity = capacity() * 2;
+    if( (d.maximumCapacity != 0) && (newCapacity > d.maximumCapacity) )
+    {
+        newCapacity = d.maximumCapacity;
+    }
+
+    const size_t count = size();
+    T *newData = new T[newCapacity + 1];
+    try
+    {
+        // Relinearize in a single pass, so the head ends up at index 0.
+        for(size_t i = 0; i < count; i++)
+        {
+            if constexpr (std::is_nothrow_move_assignable<T>::value)
+            {
+                newData[i] = std::move(d.data[(d.headIndex + i) % d.Capacity]);
+            }
+            else
+            {
+                newData[i] = d.data[(d.headIndex + i) % d.Capacity];
+            }
+        }
+    }
+    catch(...)
+    {
+        //Leave the old storage untouched.
+        delete [] newData;
+        throw;
+    }
+
+    delete [] d.data;
+    d.data = newData;
+    d.Capacity = newCapacity + 1;
+    d.headIndex = 0;
+    d.tailIndex = count;
+}
+
+template <typename T>
+bool RingBuffer<T,0>::push(const T &element)
+{
+    d.statistics.countPush();
+    size_t next = (d.tailIndex + 1) % d.Capacity;
+    size_t nextHeadIndex = d.headIndex;
+    if (next == d.headIndex) {
+        if(mayGrow())
+        {
+            growCapacity();
+            nextHeadIndex = d.headIndex;
+        }
+        else if (d.overflowPolicy == OverflowPolicy::SkipNewData)
+        {
+            d.statistics.countDrop();
+            if(d.overflowCallback)
+            {
+                d.overflowCallback(*this, d.headIndex, d.tailIndex, element);
+            }
+            return false;
+        }
+        else if (d.overflowPolicy == OverflowPolicy::OverwriteOldestData)
+        {
+            d.statistics.countOverwrite();
+            if(d.overflowCallback)
+            {
+                d.overflowCallback(*this, d.headIndex, d.tailIndex, element);
+            }
+            nextHeadIndex = (d.headIndex + 1) % d.Capacity;
+        }
+    }
+
+    try
+    {
+        d.data[d.tailIndex] = element;
+        d.tailIndex = (d.tailIndex + 1) % d.Capacity;
+        d.headIndex = nextHeadIndex;
+    }
+    catch(...)
+    {
+        //Do not update change the buffer. The element is now in undefined state.
+        throw;
+    }
+    d.statistics.updateHighWaterMark(size());
+
+    return true;
+}
+
+template <typename T>
+const T &RingBuffer<T,0>::peek() const
+{
+    if (d.headIndex == d.tailIndex) {
+        return d.outOfBoundElement;
+    }
+    return d.data[d.headIndex];
+}
+
+template <typename T>
+bool RingBuffer<T,0>::pop()
+{
+    if (d.headIndex == d.tailIndex)
+    {
+        return false; // buffer is empty
+    }
+    try
+    {
+        d.data[d.headIndex] = T();
+        d.headIndex = (d.headIndex+ 1) % d.Capacity;
+    }
+    catch (...)
+    {
+        d.headIndex = (d.headIndex+ 1) % d.Capacity;
+        throw;
+    }
+    return true;
+}
+
+template <typename T>
+size_t RingBuffer<T,0>::size() const
+{
+    return (d.tailIndex + d.Capacity - d.headIndex) % d.Capacity;
+}
+
+template <typename T>
+size_t RingBuffer<T,0>::capacity() const
+{
+    return d.Capacity - 1;
+}
+
+template <typename T>
+size_t RingBuffer<T,0>::sizeAvailable() const
+{
+    return capacity() - size();
+}
+
+template <typename T>
+void RingBuffer<T,0>::setOverRunCallBack(void (*overRunCallback)(const RingBuffer &, size_t currentHeadIndex, size_t currentTailIndex, const T& element))
+{
+    d.overflowCallback = overRunCallback;
+}
+///@endcond
+
+}
+
+
 #include <iostream>
 #include <iomanip>
 
@@ -322,7 +726,7 @@ void RingBuffer<T,S>::setOverRunCallBack(void (*overRunCallback)(const RingBuffe
 template <typename T, size_t S>
 std::ostream &operator<<(std::ostream &os, const Silica::RingBuffer<T, S> &b) {
     os << "[";
-    for(size_t i = 0; i < S; i++)
+    for(size_t i = 0; i < b.capacity(); i++)
     {
         if(i > 0)
         {
@@ -334,7 +738,7 @@ std::ostream &operator<<(std::ostream &os, const Silica::RingBuffer<T, S> &b) {
     os << "\n";
 
     os << " ";
-    for(size_t i = 0; i < S; i++)
+    for(size_t i = 0; i < b.capacity(); i++)
     {
         if(i > 0)
         {
@@ -353,7 +757,7 @@ std::ostream &operator<<(std::ostream &os, const Silica::RingBuffer<T, S> &b) {
     os << "\n";
 
     os << " ";
-    for(size_t i = 0; i < S; i++)
+    for(size_t i = 0; i < b.capacity(); i++)
     {
         if(i > 0)
         {
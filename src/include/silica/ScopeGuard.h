@@ -1,33 +1,69 @@
 #ifndef SILICA_SCOPE_GUARD_H
 #define SILICA_SCOPE_GUARD_H
 
-#include <functional>
+#include <type_traits>
+#include <utility>
+#include <silica/Macros.h>
+
 namespace Silica
 {
 
+/** \brief ScopeGuard calls a function when it goes out of scope, unless it was dismissed.
+
+The callable is held by value, so a ScopeGuard never allocates, and the call is inlined. The type of the callable is deduced, by the
+constructor or by makeScopeGuard():
+
+```cpp
+FILE *file = fopen("log.txt", "w");
+Silica::ScopeGuard closeFile([file](){ fclose(file); });
+```
+
+The callable must not throw.
+
+\ingroup Core
+ */
+template<typename F>
 class ScopeGuard
 {
-public:
+    DISABLE_COPY(ScopeGuard);
+    DISABLE_MOVE(ScopeGuard);
 
-    ScopeGuard(std::function<void()> callback)
-    {
-        d.callback = callback;
-    }
+public:
+    /** \brief Creates a ScopeGuard calling \p callback when it is destroyed. */
+    explicit ScopeGuard(F callback)
+        : d{std::move(callback), true}
+    {}
 
+    /** \brief Calls the callback, unless dismiss() was called. */
     ~ScopeGuard()
     {
-        d.callback();
+        if(d.isActive)
+        {
+            d.callback();
+        }
     }
 
+    /** \brief Keeps the callback from being called, e.g. once the operation it rolls back succeeded. */
+    void dismiss() { d.isActive = false; }
+
+    /// \cond DEVELOPER_DOC
 private:
     struct
     {
-        std::function<void()> callback;
+        F callback;
+        bool isActive;
     } d;
+    /// \endcond
 };
 
-
+/** \brief Returns a ScopeGuard calling \p callback, for use with \c auto: <tt>auto guard = makeScopeGuard([&](){ ... });</tt>
+ *  \ingroup Core */
+template<typename F>
+ScopeGuard<std::decay_t<F>> makeScopeGuard(F &&callback)
+{
+    return ScopeGuard<std::decay_t<F>>(std::forward<F>(callback));
+}
 
 }
 
-#endif // SILICA_SCOPE_GUARD
+#endif // SILICA_SCOPE_GUARD_H
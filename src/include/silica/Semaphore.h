@@ -0,0 +1,87 @@
+#ifndef SILICA_SEMAPHORE_H
+#define SILICA_SEMAPHORE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <silica/Atomic.h>
+#include <silica/Macros.h>
+#include <silica/UnitsOfTime.h>
+
+#ifndef SILICA_SEMAPHORE_SPIN_COUNT
+    /*! The number of times a Silica::Semaphore polls its count before the calling thread is parked in the operating system. */
+    #define SILICA_SEMAPHORE_SPIN_COUNT 100
+#endif
+
+namespace Silica
+{
+
+/** \brief Semaphore implements a counting semaphore that parks waiting threads in the operating system.
+
+A thread calling acquire() first spins briefly, and is then put to sleep until another thread calls release().
+On Linux the sleeping is done on a futex, and release() only wakes as many waiting threads as tokens are released.
+If nobody is waiting, release() never enters the kernel.
+
+On baremetal targets there is no thread to park, so a waiting acquire() keeps polling the count until a token is released, e.g. from an
+interrupt handler, and tryAcquireFor() measures its timeout with Application::microsecondsSinceStart(), so it requires an Application.
+
+\ingroup Core
+ */
+class Semaphore
+{
+    DISABLE_COPY(Semaphore);
+    DISABLE_MOVE(Semaphore);
+
+public:
+    /** \brief Creates a new Semaphore holding \p initialCount tokens. */
+    explicit Semaphore(int32_t initialCount = 0);
+    ~Semaphore();
+
+    /** \brief Takes a token, blocking the calling thread until one is available. */
+    void acquire();
+
+    /** \brief Takes a token, blocking the calling thread for at most \p timeout.
+     *  \returns True if a token was taken, false if the timeout expired. */
+    bool tryAcquireFor(MicroSeconds timeout);
+
+    /** \brief Takes a token if one is available, without blocking.
+     *  \returns True if a token was taken, false if not. */
+    bool tryAcquire();
+
+    /** \brief Takes up to \p maximum tokens without blocking.
+     *  \returns The number of tokens taken. */
+    size_t tryAcquireUpTo(size_t maximum);
+
+    /** \brief Adds \p count tokens and wakes at most \p count waiting threads. */
+    void release(int32_t count = 1);
+
+    /** \brief Returns the number of tokens currently available. */
+    int32_t available() const;
+
+    /// \cond DEVELOPER_DOC
+private:
+    bool acquireWithTimeout(int64_t timeoutMicroseconds);
+    bool spin();
+
+    /** Parks the calling thread while the count equals \p expected, or until \p timeoutMicroseconds has passed. A negative timeout waits forever.
+        \addtogroup PlatformRequiresImplementation */
+    void platformWait(int32_t expected, int64_t timeoutMicroseconds);
+
+    /** Wakes up to \p count threads parked in platformWait().
+        \addtogroup PlatformRequiresImplementation */
+    void platformWake(int32_t count);
+
+    /** Returns the time in microseconds on a clock that never goes backwards. Only differences of its return values are meaningful.
+        \addtogroup PlatformRequiresImplementation */
+    static int64_t platformMicroseconds();
+
+    struct
+    {
+        Atomic<int32_t> count;
+        Atomic<int32_t> waiters;
+    } d;
+    /// \endcond
+};
+
+}
+
+#endif // SILICA_SEMAPHORE_H
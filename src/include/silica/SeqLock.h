@@ -0,0 +1,117 @@
+#ifndef SILICA_SEQ_LOCK_H
+#define SILICA_SEQ_LOCK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <type_traits>
+#include <silica/Atomic.h>
+#include <silica/Macros.h>
+
+namespace Silica
+{
+
+/** \brief SeqLock holds a small value of type \c T that many threads read and few threads write.
+
+A reader copies the value and checks a sequence number before and after, retrying if a writer changed the value in between. Readers
+never write to shared memory, so they do not bounce cache lines between each other, and reading scales with the number of cores.
+Writers are serialized among themselves, and are never held up by readers. A writer does not block either, but readers retry while it
+writes, so SeqLock suits values written much less often than read, e.g. a snapshot of a configuration.
+
+\c T must be trivially copyable, and should be small: every read copies all of it, and a read overlapping a write copies it again.
+The value is kept in words accessed atomically, so that reading it while it is written is well defined.
+
+\code
+struct Route { uint32_t address; uint16_t port; };
+Silica::SeqLock<Route> route;
+
+route.store({0x0a000001, 8080});     // Any writer
+const Route current = route.load();  // Any number of readers
+\endcode
+
+\ingroup Core
+ */
+template<typename T>
+class SeqLock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLock copies its value with memcpy, T must be trivially copyable");
+
+    DISABLE_COPY(SeqLock);
+    DISABLE_MOVE(SeqLock);
+
+public:
+    /** \brief Creates a SeqLock holding \p initialValue. */
+    explicit SeqLock(const T &initialValue = T())
+    {
+        writeWords(initialValue);
+    }
+
+    /** \brief Returns a consistent copy of the value, retrying while a writer changes it. */
+    T load() const
+    {
+        Word words[wordCount];
+        for(;;)
+        {
+            const uint32_t before = d.sequence.load(std::memory_order_acquire);
+            if(before & 1)
+            {
+                continue; // A write is in progress
+            }
+            for(size_t i = 0; i < wordCount; i++)
+            {
+                words[i] = d.words[i].load(std::memory_order_relaxed);
+            }
+            atomicFence(std::memory_order_acquire);
+            if(d.sequence.load(std::memory_order_relaxed) == before)
+            {
+                break;
+            }
+        }
+        T value;
+        memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+    /** \brief Replaces the value with \p value. Concurrent writers are serialized. */
+    void store(const T &value)
+    {
+        uint32_t sequence = d.sequence.load(std::memory_order_relaxed);
+        while( (sequence & 1) || ! d.sequence.compareExchangeWeak(sequence, sequence + 1, std::memory_order_relaxed, std::memory_order_relaxed) )
+        {
+            sequence = d.sequence.load(std::memory_order_relaxed);
+        }
+        // Orders the odd sequence number before the new words, for readers
+        atomicFence(std::memory_order_release);
+        writeWords(value);
+        d.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    /** \brief Returns the number of times the value was stored, including stores still in progress. */
+    uint32_t version() const { return (d.sequence.load(std::memory_order_acquire) + 1) / 2; }
+
+    /// \cond DEVELOPER_DOC
+private:
+    using Word = uintptr_t;
+    static constexpr size_t wordCount = (sizeof(T) + sizeof(Word) - 1) / sizeof(Word);
+
+    void writeWords(const T &value)
+    {
+        Word words[wordCount] = {};
+        memcpy(words, &value, sizeof(T));
+        for(size_t i = 0; i < wordCount; i++)
+        {
+            d.words[i].store(words[i], std::memory_order_relaxed);
+        }
+    }
+
+    struct
+    {
+        Atomic<uint32_t> sequence{0};
+        Atomic<Word> words[wordCount];
+    } d;
+    /// \endcond
+};
+
+}
+
+#endif // SILICA_SEQ_LOCK_H
@@ -3,6 +3,7 @@
 
 #include <silica/Array.h>
 #include <silica/Set.h>
+#include <silica/Trace.h>
 #include <variant>
 #ifndef MAX_NUMBER_OF_CONNECTIONS_PER_SIGNAL_OR_SLOT
 #define MAX_NUMBER_OF_CONNECTIONS_PER_SIGNAL_OR_SLOT 10
@@ -21,6 +22,21 @@ template <typename ...Ts> class Slot;
 
 /// \cond DEVELOPER_DOC
 
+/*
+ * A one shot receiver of a Signal emission, kept in an intrusive list in the
+ * Signal, so waiting for a Signal neither allocates nor takes up a Connection.
+ * Waiters are removed from the Signal right before they are notified.
+ */
+template <typename ...Ts> class SignalWaiter
+{
+public:
+    virtual void signalEmitted(Ts... parameters) = 0;
+
+private:
+    friend class Signal<Ts...>;
+    SignalWaiter *nextWaiter = nullptr;
+};
+
 
 template <typename ...Ts> class Connection
 {
@@ -67,7 +83,7 @@ private:
     {
 
         #ifdef SILICA_ENABLE_LAMBDAS_IN_SIGNAL_SLOTS
-        std::function<void(Ts...)> functionObject = [](Ts...){};
+        std::function<void(Ts...)> functionObject;
         #endif
 
 
@@ -103,6 +119,18 @@ public:
 
 /** \brief Creates a new Slot<Ts...> connected to nothing and invoking the \p functionObject when invoked.
 
+A lambda capturing more than the small buffer of <tt>std::function</tt> holds is allocated on the heap. To invoke a method of an
+object, use fromMethod() instead, which never allocates.
+
+\param functionObject The function object to call, when invoked.
+*/
+    Slot(std::function<void(Ts...)> functionObject);
+
+/** \brief Creates a new Slot<Ts...> connected to nothing and invoking \p method on \p owner when invoked.
+
+The method is a template argument, so the Slot only stores \p owner and a function pointer: nothing is allocated, and no
+<tt>std::function</tt> is involved. Virtual methods are dispatched as usual.
+
 Example:
 
 ```cpp
@@ -112,7 +140,7 @@ class ClassWithSlot
 public:
 
     ClassWithSlot()
-        : printNewInt(std::bind(&MySlotOwner::doPrintNextImpl, this, std::placeholders::_1))
+        : printNewInt(Slot<int>::fromMethod<&ClassWithSlot::doPrintNextImpl>(this))
     {
     }
 
@@ -129,14 +157,21 @@ public:
 ClassWithSlot cws;
 cws.name = "SomeName";
 
-Slot<int> newInt;
-newInt.connectTo(cws.printNewInt);
+Signal<int> newInt;
+newInt.connectTo(&cws.printNewInt);
 emit newInt(117);   // Prints "SomeName got invoked with 117"
 ```
 
-\param functionObject The function object to call, when invoked.
+\param owner The object to invoke \p method on. It must outlive the Slot.
 */
-    Slot(std::function<void(Ts...)> functionObject);
+    template<auto method, typename Owner>
+    static Slot fromMethod(Owner *owner)
+    {
+        return Slot(owner, [](void *object, Ts... parameters)
+        {
+            (static_cast<Owner*>(object)->*method)(parameters...);
+        });
+    }
 
     /**
 \brief Creates a new Slot<Ts...> connected to nothing and invoking the \p freeFloatingFunction when invoked.
@@ -168,9 +203,15 @@ emit newValues(42, 3.1415);
 /// \cond DEVELOPER_DOC
 private:
     friend class Signal<Ts...>;
+
+    Slot(void *owner, void (*methodTrampoline)(void *, Ts...));
+
     struct
     {
         void (*freeFloatingFunction)(Ts...);
+        // Set by fromMethod(), calls the method on owner
+        void (*methodTrampoline)(void *, Ts...) = nullptr;
+        void *owner = nullptr;
         std::function<void(Ts...)> functionObject;
 
         Set<Signal<Ts...>*, MAX_NUMBER_OF_CONNECTIONS_PER_SIGNAL_OR_SLOT> sources;
@@ -318,6 +359,12 @@ public:
 
     bool connectTo(std::function<void(Ts...)> target);
 #endif
+
+    /// \cond DEVELOPER_DOC
+    void addWaiter(SignalWaiter<Ts...> *waiter);
+    void removeWaiter(SignalWaiter<Ts...> *waiter);
+    /// \endcond
+
 private:
     /// \cond DEVELOPER_DOC
     friend class Slot<Ts...>;
@@ -326,6 +373,7 @@ private:
     struct
     {
         Array<Connection<Ts...>, MAX_NUMBER_OF_CONNECTIONS_PER_SIGNAL_OR_SLOT> connections;
+        SignalWaiter<Ts...> *firstWaiter = nullptr;
     } d;
     /// \endcond
 };
@@ -345,10 +393,40 @@ private:
 
 template <typename ...Ts>  void Silica::Signal<Ts...>::operator()(Ts... parameters)
 {
+    TraceScope trace("Signal::emit", this);
     for(auto &connection : d.connections)
     {
         connection.distributeInvocation(parameters...);
     }
+
+    SignalWaiter<Ts...> *waiter = d.firstWaiter;
+    d.firstWaiter = nullptr;
+    while(waiter)
+    {
+        SignalWaiter<Ts...> *next = waiter->nextWaiter;
+        waiter->nextWaiter = nullptr;
+        waiter->signalEmitted(parameters...);
+        waiter = next;
+    }
+}
+
+template <typename ...Ts> void Silica::Signal<Ts...>::addWaiter(SignalWaiter<Ts...> *waiter)
+{
+    waiter->nextWaiter = d.firstWaiter;
+    d.firstWaiter = waiter;
+}
+
+template <typename ...Ts> void Silica::Signal<Ts...>::removeWaiter(SignalWaiter<Ts...> *waiter)
+{
+    for(SignalWaiter<Ts...> **link = &d.firstWaiter; *link; link = &(*link)->nextWaiter)
+    {
+        if(*link == waiter)
+        {
+            *link = waiter->nextWaiter;
+            waiter->nextWaiter = nullptr;
+            return;
+        }
+    }
 }
 
 template <typename ...Ts> bool Silica::Signal<Ts...>::connectTo(Slot<Ts...> *target)
@@ -430,6 +508,13 @@ template <typename ...Ts> Silica::Slot<Ts...>::Slot(std::function<void(Ts...)> f
 
 }
 
+template <typename ...Ts> Silica::Slot<Ts...>::Slot(void *owner, void (*methodTrampoline)(void *, Ts...))
+{
+    this->d.freeFloatingFunction = nullptr;
+    this->d.methodTrampoline = methodTrampoline;
+    this->d.owner = owner;
+}
+
 template <typename ...Ts> void Silica::Slot<Ts...>::operator()(Ts... parameters)
 {
     this->invoke(parameters...);
@@ -441,6 +526,10 @@ template <typename ...Ts> void Silica::Slot<Ts...>::invoke(Ts... parameters)
     {
         d.freeFloatingFunction(parameters...);
     }
+    else if(d.methodTrampoline)
+    {
+        d.methodTrampoline(d.owner, parameters...);
+    }
     else if(d.functionObject)
     {
         d.functionObject(parameters...);
@@ -510,6 +599,7 @@ Silica::Connection<Ts...>::Connection(Signal<Ts...> *source, std::function<void(
 template <typename... Ts>
 void Silica::Connection<Ts...>::distributeInvocation(Ts... parameters)
 {
+    TraceScope trace("Connection::invoke", this);
     if(d.connectionType == Connection::Type::Direct)
     {
 
@@ -0,0 +1,216 @@
+#ifndef SILICA_TASK_H
+#define SILICA_TASK_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef SILICA_TASK_INLINE_SIZE
+    /*! The number of bytes a Silica::Task reserves for the callable it holds. Callables with larger captures are rejected at compile time.
+    E.g.:
+
+    <code>
+        g++ -DSILICA_TASK_INLINE_SIZE=128 myFile.cpp ...
+    </code>
+    */
+    #define SILICA_TASK_INLINE_SIZE (6 * sizeof(void*))
+#endif
+
+namespace Silica
+{
+
+/** \brief Task holds a callable taking no arguments and returning nothing, without any dynamic allocation.
+
+The callable, e.g. a lambda and its captures, is stored inside the Task itself in \ref SILICA_TASK_INLINE_SIZE bytes.
+Callables that do not fit are rejected at compile time, so handing a Task from one thread to another never touches the heap.
+
+Tasks can be moved but not copied.
+
+```cpp
+int counter = 0;
+Silica::Task task([&counter](){ counter++; });
+task();   // counter is now 1
+```
+
+\ingroup Core
+*/
+class Task
+{
+public:
+    /** \brief Creates an empty Task. Invoking an empty Task does nothing. */
+    Task() = default;
+
+    /** \brief Creates a Task holding a copy of \p callable. */
+    template <typename F, typename std::enable_if<!std::is_same<typename std::decay<F>::type, Task>::value, int>::type = 0>
+    Task(F &&callable)
+    {
+        using Callable = typename std::decay<F>::type;
+        static_assert(sizeof(Callable) <= SILICA_TASK_INLINE_SIZE, "The callable is too large for a Silica::Task. Capture less or increase SILICA_TASK_INLINE_SIZE.");
+        static_assert(alignof(Callable) <= alignof(std::max_align_t), "The callable is overaligned for a Silica::Task.");
+
+        new (d.storage) Callable(std::forward<F>(callable));
+        d.invoke = [](void *storage) { (*static_cast<Callable*>(storage))(); };
+        d.relocate = [](void *destination, void *source) {
+            if(destination)
+            {
+                new (destination) Callable(std::move(*static_cast<Callable*>(source)));
+            }
+            static_cast<Callable*>(source)->~Callable();
+        };
+    }
+
+    Task(Task &&other)
+    {
+        takeFrom(other);
+    }
+
+    Task &operator=(Task &&other)
+    {
+        if(this != &other)
+        {
+            reset();
+            takeFrom(other);
+        }
+        return *this;
+    }
+
+    Task(const Task &) = delete;
+    Task &operator=(const Task &) = delete;
+
+    ~Task()
+    {
+        reset();
+    }
+
+    /** \brief Invokes the held callable, if any. */
+    void operator()()
+    {
+        if(d.invoke)
+        {
+            d.invoke(d.storage);
+        }
+    }
+
+    /** \brief Returns true if this Task holds a callable. */
+    explicit operator bool() const
+    {
+        return d.invoke != nullptr;
+    }
+
+    /** \brief Destroys the held callable, leaving this Task empty. */
+    void reset()
+    {
+        if(d.relocate)
+        {
+            d.relocate(nullptr, d.storage);
+        }
+        d.invoke = nullptr;
+        d.relocate = nullptr;
+    }
+
+    /// \cond DEVELOPER_DOC
+private:
+    void takeFrom(Task &other)
+    {
+        if(other.d.relocate)
+        {
+            other.d.relocate(d.storage, other.d.storage);
+        }
+        d.invoke = other.d.invoke;
+        d.relocate = other.d.relocate;
+        other.d.invoke = nullptr;
+        other.d.relocate = nullptr;
+    }
+
+    struct
+    {
+        alignas(std::max_align_t) unsigned char storage[SILICA_TASK_INLINE_SIZE];
+        void (*invoke)(void *storage) = nullptr;
+        void (*relocate)(void *destination, void *source) = nullptr;
+    } d;
+    /// \endcond
+};
+
+
+/// \cond DEVELOPER_DOC
+/*
+ * A growable double ended queue of Tasks. The storage only grows, so a
+ * queue that has reached its working size never allocates again.
+ * TaskDeque does no locking.
+ */
+class TaskDeque
+{
+public:
+    TaskDeque() = default;
+    TaskDeque(const TaskDeque &) = delete;
+    TaskDeque &operator=(const TaskDeque &) = delete;
+
+    ~TaskDeque()
+    {
+        delete [] d.tasks;
+    }
+
+    size_t size() const { return d.count; }
+
+    void pushBack(Task &&task)
+    {
+        if(d.count == d.capacity)
+        {
+            grow();
+        }
+        d.tasks[(d.head + d.count) & (d.capacity - 1)] = std::move(task);
+        d.count++;
+    }
+
+    bool popBack(Task &destination)
+    {
+        if(d.count == 0)
+        {
+            return false;
+        }
+        d.count--;
+        destination = std::move(d.tasks[(d.head + d.count) & (d.capacity - 1)]);
+        return true;
+    }
+
+    bool popFront(Task &destination)
+    {
+        if(d.count == 0)
+        {
+            return false;
+        }
+        destination = std::move(d.tasks[d.head]);
+        d.head = (d.head + 1) & (d.capacity - 1);
+        d.count--;
+        return true;
+    }
+
+private:
+    void grow()
+    {
+        const size_t newCapacity = d.capacity ? d.capacity * 2 : 16;
+        Task *newTasks = new Task[newCapacity];
+        for(size_t i = 0; i < d.count; i++)
+        {
+            newTasks[i] = std::move(d.tasks[(d.head + i) & (d.capacity - 1)]);
+        }
+        delete [] d.tasks;
+        d.tasks = newTasks;
+        d.capacity = newCapacity;
+        d.head = 0;
+    }
+
+    struct
+    {
+        Task *tasks = nullptr;
+        size_t capacity = 0;
+        size_t head = 0;
+        size_t count = 0;
+    } d;
+};
+/// \endcond
+
+}
+
+#endif // SILICA_TASK_H
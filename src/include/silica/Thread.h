@@ -0,0 +1,137 @@
+#ifndef SILICA_THREAD_H
+#define SILICA_THREAD_H
+
+#if ! ( \
+       defined(SILICA_OS_WINDOWS) \
+    || defined(SILICA_OS_LINUX) \
+    || defined(SILICA_OS_MACOS) )
+
+        #error "Thread requires an operating system providing threads."
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+#include <silica/Macros.h>
+#include <silica/Semaphore.h>
+#include <silica/Task.h>
+
+namespace Silica
+{
+
+/** \brief Thread runs a Task on a thread of its own, pinned to CPUs, with real-time priority, a name and a stack size of choice.
+
+Set up the Thread with the setters, then start() it. The settings are applied by the new thread to itself, before it runs the Task.
+start() waits for that, so once it returns true, the thread runs exactly as configured. If a setting cannot be applied, e.g. real-time
+priority without the privilege to use it, the Task is not run at all, a warning is logged and start() returns false. A latency critical
+thread thus never runs on a core or with a priority it was not meant to.
+
+Pinning a thread to an isolated core with real-time priority is how a thread gets deterministic latency. To host the event loop of the
+Application on such a thread, run Application::exec() as its Task:
+
+```cpp
+Silica::Application app;
+Silica::Thread loopThread;
+loopThread.setName("event-loop");
+loopThread.setAffinity(uint64_t(1) << 3);      // CPU 3 only
+loopThread.setRealTimePriority(80);
+if( ! loopThread.start([&app](){ app.exec(); }) )
+{
+    // Not pinned, or no real-time priority
+}
+loopThread.join();
+```
+
+The destructor joins a started Thread, so the Task must return by then.
+
+\ingroup Core
+ */
+class Thread
+{
+    DISABLE_COPY(Thread);
+    DISABLE_MOVE(Thread);
+
+public:
+    /** \brief The longest name a Thread takes, longer ones are cut. The limit of Linux. */
+    static constexpr size_t nameMaxLength = 15;
+
+    /** \brief Creates a Thread that is not started yet, with default settings. */
+    Thread();
+
+    /** \brief Joins the thread, if it was started. */
+    ~Thread();
+
+    /** \brief Sets the name of the thread, shown by debuggers and tools like \c top. At most \ref nameMaxLength characters are kept. */
+    void setName(const char *name);
+
+    /** \brief Returns the name set with setName(). */
+    const char *name() const { return d.name; }
+
+    /** \brief Sets the size of the stack of the thread in bytes. 0, the default, uses the default of the operating system. */
+    void setStackSize(size_t bytes) { d.stackSize = bytes; }
+
+    /** \brief Returns the stack size set with setStackSize(). */
+    size_t stackSize() const { return d.stackSize; }
+
+    /** \brief Restricts the thread to the CPUs of \p cpuMask, bit \c i for CPU \c i. 0, the default, lets it run on all CPUs. */
+    void setAffinity(uint64_t cpuMask) { d.affinity = cpuMask; }
+
+    /** \brief Returns the CPU mask set with setAffinity(). */
+    uint64_t affinity() const { return d.affinity; }
+
+    /** \brief Runs the thread with real-time priority \p priority, 1 to 99, the higher the more urgent. 0, the default, keeps normal
+     *  scheduling.
+     *
+     *  On Linux, the thread is scheduled with \c SCHED_FIFO, requiring root or \c CAP_SYS_NICE. A real-time thread runs until it
+     *  blocks or a more urgent one is ready, so it must not spin forever. On Windows, any priority above 0 makes the thread time critical. */
+    void setRealTimePriority(int priority) { d.realTimePriority = priority; }
+
+    /** \brief Returns the priority set with setRealTimePriority(). */
+    int realTimePriority() const { return d.realTimePriority; }
+
+    /** \brief Starts the thread, which applies the settings to itself and then runs \p entry.
+     *  \returns True if the thread runs \p entry with all settings applied. False if this Thread was started before, or the thread
+     *  could not be created or configured, in which case \p entry is not run. */
+    bool start(Task entry);
+
+    /** \brief Waits for the Task of the thread to return. Returns right away if the Thread was not started or is joined already. */
+    void join();
+
+    /** \brief Returns true if start() succeeded and the thread was not joined yet. The Task may have returned already. */
+    bool isJoinable() const { return d.isStarted; }
+
+    /// \cond DEVELOPER_DOC
+private:
+    static void run(Thread *thread);
+
+    /** Creates the native thread with the stack size set, running run() with this Thread.
+        \returns False if the thread could not be created.
+        \addtogroup PlatformRequiresImplementation */
+    bool platformStart();
+
+    /** Waits for the native thread to exit and releases it.
+        \addtogroup PlatformRequiresImplementation */
+    void platformJoin();
+
+    /** Applies the name, affinity and priority to the calling thread, logging a warning for each one that fails.
+        \returns False if the affinity or priority could not be applied.
+        \addtogroup PlatformRequiresImplementation */
+    bool platformConfigureCurrentThread();
+
+    struct
+    {
+        char name[nameMaxLength + 1] = {};
+        size_t stackSize = 0;
+        uint64_t affinity = 0;
+        int realTimePriority = 0;
+        Task entry;
+        Semaphore configured{0};
+        bool isConfigured = false;   // Written by the thread before it releases configured
+        bool isStarted = false;
+        uintptr_t handle = 0;        // The native thread, pthread_t or HANDLE
+    } d;
+    /// \endcond
+};
+
+}
+
+#endif // SILICA_THREAD_H
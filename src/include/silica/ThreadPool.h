@@ -0,0 +1,96 @@
+#ifndef SILICA_THREAD_POOL_H
+#define SILICA_THREAD_POOL_H
+
+#if ! ( \
+       defined(SILICA_OS_WINDOWS) \
+    || defined(SILICA_OS_LINUX) \
+    || defined(SILICA_OS_MACOS) )
+
+        #error "ThreadPool requires an operating system providing threads."
+#endif
+
+#include <stddef.h>
+#include <atomic>
+#include <thread>
+#include <silica/Array.h>
+#include <silica/Macros.h>
+#include <silica/Mutex.h>
+#include <silica/Semaphore.h>
+#include <silica/Task.h>
+
+namespace Silica
+{
+
+/** \brief ThreadPool runs [Tasks](\ref Task) on a set of worker threads, away from the event loop.
+
+Each worker owns a deque of Tasks. Tasks posted from a worker, e.g. subtasks, go to the back of that worker's own deque and are taken
+from the back again, so recently created work runs while it is still in cache. Tasks posted from other threads are spread over the
+workers round robin. A worker that runs out of work steals from the front of the other workers' deques. Idle workers sleep on a
+Semaphore, and posting a Task wakes at most one of them.
+
+A ThreadPool attaches itself to the Application when constructed, after which Application::post() and Application::runAsync()
+use it. Hence, the Application must be instantiated before the ThreadPool, and at most one ThreadPool may exist at a time.
+
+```cpp
+Silica::Application app;
+Silica::ThreadPool pool;            // One worker per core
+
+Silica::Signal<int> answerReady;
+answerReady.connectTo([](int answer){
+    LOG("The answer is %d", answer);    // Runs on the event loop thread
+});
+
+app.runAsync([](){ return computeTheAnswer(); }, &answerReady);
+return app.exec();
+```
+
+\ingroup Core
+*/
+class ThreadPool
+{
+    DISABLE_COPY(ThreadPool);
+    DISABLE_MOVE(ThreadPool);
+
+public:
+    /** \brief Starts \p workerCount worker threads and attaches this ThreadPool to the Application.
+    \param workerCount The number of workers. 0 starts one worker per hardware thread.
+    */
+    explicit ThreadPool(size_t workerCount = 0);
+
+    /** \brief Runs all Tasks already posted, then stops and joins the workers and detaches from the Application. */
+    ~ThreadPool();
+
+    /** \brief Queues \p task to be run on one of the workers.
+    \returns True if the task was queued, false if this ThreadPool is shutting down.
+    */
+    bool post(Task task);
+
+    /** \brief Returns the number of worker threads. */
+    size_t workerCount() const { return d.workers.size(); }
+
+    /// \cond DEVELOPER_DOC
+private:
+    struct Worker
+    {
+        Mutex mutex{"ThreadPool::Worker::mutex"};
+        TaskDeque tasks;
+        std::thread thread;
+        size_t index = 0;
+    };
+
+    void run(Worker *self);
+    bool takeTask(Worker *self, Task &destination);
+
+    struct
+    {
+        Array<Worker *> workers;
+        Semaphore pendingTasks{0};
+        std::atomic<size_t> nextWorker{0};
+        std::atomic<bool> stopping{false};
+    } d;
+    /// \endcond
+};
+
+}
+
+#endif // SILICA_THREAD_POOL_H
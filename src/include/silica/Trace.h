@@ -0,0 +1,121 @@
+#ifndef SILICA_TRACE_H
+#define SILICA_TRACE_H
+
+#include <stddef.h>
+#include <stdio.h>
+#include <silica/Atomic.h>
+#include <silica/Macros.h>
+
+#ifndef SILICA_TRACE_EVENTS_PER_THREAD
+    /*! The number of events each thread keeps for Silica::Trace. Once full, new events of that thread are dropped until the trace is written. */
+    #define SILICA_TRACE_EVENTS_PER_THREAD 4096
+#endif
+
+namespace Silica
+{
+
+/** \brief Trace records a timeline of what the event loop does, for viewing in chrome://tracing or the Perfetto UI.
+
+While tracing is started, Silica records the beginning and end of:
+
+ - every pass of Application::exec(), named \c "Application::pass",
+ - running the Tasks queued with Application::invokeOnLoop(), named \c "Application::runQueuedTasks",
+ - every EventGenerator::visit(), named \c "EventGenerator::visit",
+ - every Signal emission, named \c "Signal::emit",
+ - every Connection invoked by an emission, named \c "Connection::invoke",
+ - every CoarseTimer trigger, named \c "CoarseTimer::triggered".
+
+Each event carries the address of the object involved. Applications may record their own events with TraceScope.
+
+Events go into a ring buffer of \ref SILICA_TRACE_EVENTS_PER_THREAD events per thread, so recording never locks nor allocates,
+except for the first event of each thread. A full buffer keeps its oldest events and drops new ones, which lets writeChromeTrace()
+run while other threads are recording. When tracing is stopped, recording costs a single, well predicted branch.
+
+```cpp
+Silica::Trace::start();
+app.exec();
+Silica::Trace::stop();
+Silica::Trace::writeChromeTrace("loop.json");
+```
+
+\note Tracing requires an Application, which provides the timestamps. Events recorded while there is none are dropped.
+\ingroup Core
+*/
+class Trace
+{
+public:
+    /** \brief Discards previously recorded events and starts recording. */
+    static void start();
+
+    /** \brief Stops recording. */
+    static void stop();
+
+    /** \brief Returns true while recording. */
+    static bool isEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+    /** \brief Records the beginning of \p name on the calling thread. \p name must be a string literal or otherwise outlive the trace. */
+    static void begin(const char *name, const void *object = nullptr);
+
+    /** \brief Records the end of \p name on the calling thread. */
+    static void end(const char *name, const void *object = nullptr);
+
+    /** \brief Records a point in time named \p name on the calling thread. */
+    static void instant(const char *name, const void *object = nullptr);
+
+    /** \brief Writes the recorded events of all threads to \p file in the Chrome trace event JSON format, and discards them.
+     *  Events recorded by other threads while writing are either written or kept for the next call.
+     *  \returns The number of events written.
+     */
+    static size_t writeChromeTrace(FILE *file);
+
+    /** \brief Writes the recorded events to the file \p path. See writeChromeTrace(FILE*).
+     *  \returns True if the file could be written, false if not.
+     */
+    static bool writeChromeTrace(const char *path);
+
+private:
+    /// \cond DEVELOPER_DOC
+    static void record(char phase, const char *name, const void *object);
+    static Atomic<bool> enabled;
+    /// \endcond
+};
+
+
+/** \brief TraceScope records the beginning of \p name when constructed and its end when destroyed, if tracing is enabled.
+
+\ingroup Core
+*/
+class TraceScope
+{
+    DISABLE_COPY(TraceScope);
+    DISABLE_MOVE(TraceScope);
+
+public:
+    explicit TraceScope(const char *name, const void *object = nullptr)
+        : name(name),
+          object(object),
+          isRecording(Trace::isEnabled())
+    {
+        if(isRecording)
+        {
+            Trace::begin(name, object);
+        }
+    }
+
+    ~TraceScope()
+    {
+        if(isRecording)
+        {
+            Trace::end(name, object);
+        }
+    }
+
+private:
+    const char *name;
+    const void *object;
+    bool isRecording;
+};
+
+}
+
+#endif // SILICA_TRACE_H
@@ -0,0 +1,94 @@
+#include <silica/FileLogSink.h>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+#include <errno.h>
+
+namespace Silica
+{
+
+int64_t FileLogSink::platformOpen()
+{
+    const int fd = ::open(d.path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    d.handle = fd;
+    if(fd < 0)
+    {
+        d.handle = -1;
+        return -1;
+    }
+    struct stat status;
+    if(fstat(fd, &status) != 0)
+    {
+        return 0;
+    }
+    return status.st_size;
+}
+
+bool FileLogSink::platformWrite(const Segment *segments, size_t count)
+{
+    struct iovec vectors[SILICA_FILE_LOG_SINK_CHUNKS];
+    for(size_t i = 0; i < count; i++)
+    {
+        vectors[i].iov_base = const_cast<char*>(segments[i].data);
+        vectors[i].iov_len = segments[i].length;
+    }
+
+    struct iovec *remaining = vectors;
+    size_t remainingCount = count;
+    while(remainingCount)
+    {
+        const ssize_t written = ::writev(static_cast<int>(d.handle), remaining, static_cast<int>(remainingCount));
+        if(written < 0)
+        {
+            if(errno == EINTR)
+            {
+                continue;
+            }
+            return false;
+        }
+
+        // Only on a partial write, e.g. a full disk or a signal, is another call needed.
+        size_t bytes = static_cast<size_t>(written);
+        while(remainingCount && (bytes >= remaining->iov_len))
+        {
+            bytes -= remaining->iov_len;
+            remaining++;
+            remainingCount--;
+        }
+        if(remainingCount)
+        {
+            remaining->iov_base = static_cast<char*>(remaining->iov_base) + bytes;
+            remaining->iov_len -= bytes;
+        }
+    }
+    return true;
+}
+
+void FileLogSink::platformSync()
+{
+    if(d.handle != -1)
+    {
+        ::fdatasync(static_cast<int>(d.handle));
+    }
+}
+
+void FileLogSink::platformClose()
+{
+    if(d.handle != -1)
+    {
+        ::close(static_cast<int>(d.handle));
+        d.handle = -1;
+    }
+}
+
+uint64_t FileLogSink::platformMilliseconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return uint64_t(now.tv_sec) * 1000 + now.tv_nsec / 1000000;
+}
+
+}
@@ -0,0 +1,55 @@
+#include <silica/FlightRecorderLogSink.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Silica
+{
+
+void *FlightRecorderLogSink::platformMap(size_t size)
+{
+    const int fd = ::open(d.path, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if(fd < 0)
+    {
+        return nullptr;
+    }
+    struct stat status;
+    if( (fstat(fd, &status) != 0) || ( (static_cast<size_t>(status.st_size) != size) && (ftruncate(fd, size) != 0) ) )
+    {
+        ::close(fd);
+        return nullptr;
+    }
+    void *mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if(mapping == MAP_FAILED)
+    {
+        ::close(fd);
+        return nullptr;
+    }
+    d.file = fd;
+    d.size = size;
+    return mapping;
+}
+
+void FlightRecorderLogSink::platformSync()
+{
+    msync(d.header, d.size, MS_SYNC);
+}
+
+void FlightRecorderLogSink::platformUnmap()
+{
+    if(d.header)
+    {
+        munmap(d.header, d.size);
+        d.header = nullptr;
+        d.records = nullptr;
+    }
+    if(d.file != -1)
+    {
+        ::close(static_cast<int>(d.file));
+        d.file = -1;
+    }
+}
+
+}
@@ -0,0 +1,25 @@
+#include <silica/LogEntry.h>
+
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace Silica
+{
+
+uint64_t LogEntry::platformTimestamp()
+{
+    // Read from memory shared with the kernel, without a system call.
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return uint64_t(now.tv_sec) * 1000000000 + now.tv_nsec;
+}
+
+uint32_t LogEntry::platformThreadId()
+{
+    // gettid() is a system call, so it is asked once per thread.
+    static thread_local const uint32_t threadId = static_cast<uint32_t>(syscall(SYS_gettid));
+    return threadId;
+}
+
+}
@@ -0,0 +1,16 @@
+#include <silica/LogRateLimit.h>
+
+#include <time.h>
+
+namespace Silica
+{
+
+uint64_t LogRateLimit::platformMicroseconds()
+{
+    // The coarse clock is read from memory shared with the kernel, without a system call.
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+    return uint64_t(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+}
+
+}
@@ -1,32 +1,30 @@
 #include <silica/Mutex.h>
 
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
 namespace Silica
 {
 
+static_assert(sizeof(Atomic<int32_t>) == sizeof(int32_t), "The futex requires Atomic<int32_t> to be layout compatible with int32_t.");
 
-Mutex::Mutex()
-{}
-
-Mutex::~Mutex()
-{}
-
-void Mutex::lock()
+void Mutex::platformWait(int32_t expected)
 {
-    d.mutex.lock();
+    syscall(SYS_futex, reinterpret_cast<int32_t*>(&d.state), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
 }
 
-void Mutex::unlock()
+void Mutex::platformWake()
 {
-    d.mutex.unlock();
-
+    syscall(SYS_futex, reinterpret_cast<int32_t*>(&d.state), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
 }
 
-bool Mutex::tryLock()
+uint64_t Mutex::platformNanoseconds()
 {
-    return d.mutex.try_lock();
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return uint64_t(now.tv_sec) * 1000000000u + uint64_t(now.tv_nsec);
 }
 
-
-};
-
-
+}
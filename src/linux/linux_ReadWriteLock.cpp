@@ -0,0 +1,21 @@
+#include <silica/ReadWriteLock.h>
+
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace Silica
+{
+
+void ReadWriteLock::platformWait(int32_t expected)
+{
+    syscall(SYS_futex, reinterpret_cast<int32_t*>(&d.state), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+void ReadWriteLock::platformWakeAll()
+{
+    syscall(SYS_futex, reinterpret_cast<int32_t*>(&d.state), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+}
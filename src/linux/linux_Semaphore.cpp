@@ -0,0 +1,38 @@
+#include <silica/Semaphore.h>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace Silica
+{
+
+static_assert(sizeof(Atomic<int32_t>) == sizeof(int32_t), "The futex requires Atomic<int32_t> to be layout compatible with int32_t.");
+
+void Semaphore::platformWait(int32_t expected, int64_t timeoutMicroseconds)
+{
+    struct timespec timeout;
+    struct timespec *timeoutPointer = nullptr;
+    if(timeoutMicroseconds >= 0)
+    {
+        timeout.tv_sec = timeoutMicroseconds / 1000000;
+        timeout.tv_nsec = (timeoutMicroseconds % 1000000) * 1000;
+        timeoutPointer = &timeout;
+    }
+    syscall(SYS_futex, reinterpret_cast<int32_t*>(&d.count), FUTEX_WAIT_PRIVATE, expected, timeoutPointer, nullptr, 0);
+}
+
+void Semaphore::platformWake(int32_t count)
+{
+    syscall(SYS_futex, reinterpret_cast<int32_t*>(&d.count), FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+int64_t Semaphore::platformMicroseconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return int64_t(now.tv_sec) * 1000000 + now.tv_nsec / 1000;
+}
+
+}
@@ -0,0 +1,90 @@
+#include <silica/Thread.h>
+#include <silica/LoggingSystem.h>
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+
+namespace Silica
+{
+
+static_assert(sizeof(pthread_t) <= sizeof(uintptr_t), "The handle of a Thread must hold a pthread_t.");
+
+bool Thread::platformStart()
+{
+    pthread_attr_t attributes;
+    pthread_attr_init(&attributes);
+    if(d.stackSize)
+    {
+        const int error = pthread_attr_setstacksize(&attributes, d.stackSize);
+        if(error)
+        {
+            WARN("Thread stack size: %s", strerror(error));
+            pthread_attr_destroy(&attributes);
+            return false;
+        }
+    }
+    pthread_t handle;
+    const int error = pthread_create(&handle, &attributes, [](void *thread) -> void* {
+        run(static_cast<Thread*>(thread));
+        return nullptr;
+    }, this);
+    pthread_attr_destroy(&attributes);
+    if(error)
+    {
+        WARN("Thread not created: %s", strerror(error));
+        return false;
+    }
+    d.handle = static_cast<uintptr_t>(handle);
+    return true;
+}
+
+void Thread::platformJoin()
+{
+    pthread_join(static_cast<pthread_t>(d.handle), nullptr);
+}
+
+bool Thread::platformConfigureCurrentThread()
+{
+    if(d.name[0])
+    {
+        pthread_setname_np(pthread_self(), d.name);
+    }
+
+    if(d.affinity)
+    {
+        cpu_set_t cpus;
+        CPU_ZERO(&cpus);
+        for(int cpu = 0; cpu < 64; cpu++)
+        {
+            if(d.affinity & (uint64_t(1) << cpu))
+            {
+                CPU_SET(cpu, &cpus);
+            }
+        }
+        const int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+        if(error)
+        {
+            WARN("Thread affinity: %s", strerror(error));
+            return false;
+        }
+    }
+
+    if(d.realTimePriority > 0)
+    {
+        struct sched_param parameters = {};
+        const int minimum = sched_get_priority_min(SCHED_FIFO);
+        const int maximum = sched_get_priority_max(SCHED_FIFO);
+        parameters.sched_priority = (d.realTimePriority < minimum) ? minimum : (d.realTimePriority > maximum) ? maximum : d.realTimePriority;
+        const int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters);
+        if(error)
+        {
+            WARN("Thread SCHED_FIFO: %s", strerror(error));
+            return false;
+        }
+    }
+    return true;
+}
+
+}
@@ -13,39 +13,53 @@
 class OperatingSystemWithPrintfLogSink : public Silica::LogSink
 {
 public:
-    void sinkEntry(const Silica::LogEntry &entry) override
+    void sinkRecord(const Silica::LogRecord &record) override
     {
+        const Silica::LogEntry &entry = record.entry();
         const char *color;
         FILE* descriptor;
-        char indicator;
         switch(entry.type())
         {
+        case Silica::LogEntry::Type::Trace:
+            color = TEXT_CYAN;
+            descriptor = stdout;
+            break;
+        case Silica::LogEntry::Type::Debug:
+            color = TEXT_BLUE;
+            descriptor = stdout;
+            break;
         case Silica::LogEntry::Type::Log:
             color = TEXT_NORMAL;
             descriptor = stdout;
-            indicator = 'L';
             break;
         case Silica::LogEntry::Type::Warning:
             color = TEXT_YELLOW;
             descriptor = stdout;
-            indicator = 'W';
             break;
         case Silica::LogEntry::Type::Fatal:
             color = TEXT_RED;
             descriptor = stderr;
-            indicator = 'F';
             break;
         }
 
-        fprintf(descriptor, "%s# %c : %4zu : %-*s : %s\n" TEXT_NORMAL, color, indicator, entry.originatingLine(), SILICA_LOGENTRY_FILENAME_MAX_LENGTH, entry.originatingFile(), entry.message());
-        fflush(descriptor);
+        fputs(color, descriptor);
+        fwrite(record.text(), 1, record.textLength(), descriptor);
+        fputs(TEXT_NORMAL, descriptor);
 
         if(entry.type() == Silica::LogEntry::Type::Fatal)
         {
+            fflush(stdout);
+            fflush(stderr);
             ::exit(1);
         }
 
     };
+
+    void flush() override
+    {
+        fflush(stdout);
+        fflush(stderr);
+    }
 };
 
 OperatingSystemWithPrintfLogSink sink;
@@ -5,5 +5,12 @@ set( silica_sources
     ${silica_sources}
     ${HERE}/${SILICA_OS_ARCH_PREFIX}_application.cpp
     ${HERE}/${SILICA_OS_ARCH_PREFIX}_event_logging.cpp
+    ${HERE}/${SILICA_OS_ARCH_PREFIX}_FileLogSink.cpp
+    ${HERE}/${SILICA_OS_ARCH_PREFIX}_FlightRecorderLogSink.cpp
+    ${HERE}/${SILICA_OS_ARCH_PREFIX}_LogEntry.cpp
+    ${HERE}/${SILICA_OS_ARCH_PREFIX}_LogRateLimit.cpp
     ${HERE}/${SILICA_OS_ARCH_PREFIX}_Mutex.cpp
+    ${HERE}/${SILICA_OS_ARCH_PREFIX}_ReadWriteLock.cpp
+    ${HERE}/${SILICA_OS_ARCH_PREFIX}_Semaphore.cpp
+    ${HERE}/${SILICA_OS_ARCH_PREFIX}_Thread.cpp
 )
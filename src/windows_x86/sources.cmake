@@ -3,7 +3,14 @@ set( SILICA_OS_ARCH_PREFIX windows_x86)
 set( HERE src/${SILICA_OS_ARCH_PREFIX} )
 set( silica_sources
     ${silica_sources}
+    ${HERE}/${SILICA_OS_ARCH_PREFIX}_FileLogSink.cpp
+    ${HERE}/${SILICA_OS_ARCH_PREFIX}_FlightRecorderLogSink.cpp
+    ${HERE}/${SILICA_OS_ARCH_PREFIX}_LogEntry.cpp
+    ${HERE}/${SILICA_OS_ARCH_PREFIX}_LogRateLimit.cpp
     ${HERE}/${SILICA_OS_ARCH_PREFIX}_Mutex.cpp
+    ${HERE}/${SILICA_OS_ARCH_PREFIX}_ReadWriteLock.cpp
+    ${HERE}/${SILICA_OS_ARCH_PREFIX}_Semaphore.cpp
+    ${HERE}/${SILICA_OS_ARCH_PREFIX}_Thread.cpp
     ${HERE}/${SILICA_OS_ARCH_PREFIX}_event_logging.cpp
     ${HERE}/${SILICA_OS_ARCH_PREFIX}_application.cpp
 	 
@@ -0,0 +1,63 @@
+#include <silica/FileLogSink.h>
+
+#include <windows.h>
+
+namespace Silica
+{
+
+int64_t FileLogSink::platformOpen()
+{
+    const HANDLE file = CreateFileA(d.path, FILE_APPEND_DATA, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                    nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE)
+    {
+        d.handle = -1;
+        return -1;
+    }
+    d.handle = reinterpret_cast<intptr_t>(file);
+    LARGE_INTEGER size;
+    if( ! GetFileSizeEx(file, &size) )
+    {
+        return 0;
+    }
+    return size.QuadPart;
+}
+
+bool FileLogSink::platformWrite(const Segment *segments, size_t count)
+{
+    // Windows only gathers page aligned buffers of unbuffered files, so every chunk takes a call of its own.
+    const HANDLE file = reinterpret_cast<HANDLE>(d.handle);
+    for(size_t i = 0; i < count; i++)
+    {
+        DWORD written = 0;
+        if( ! WriteFile(file, segments[i].data, static_cast<DWORD>(segments[i].length), &written, nullptr) )
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void FileLogSink::platformSync()
+{
+    if(d.handle != -1)
+    {
+        FlushFileBuffers(reinterpret_cast<HANDLE>(d.handle));
+    }
+}
+
+void FileLogSink::platformClose()
+{
+    if(d.handle != -1)
+    {
+        CloseHandle(reinterpret_cast<HANDLE>(d.handle));
+        d.handle = -1;
+    }
+}
+
+uint64_t FileLogSink::platformMilliseconds()
+{
+    return GetTickCount64();
+}
+
+}
@@ -0,0 +1,70 @@
+#include <silica/FlightRecorderLogSink.h>
+
+#include <windows.h>
+
+namespace Silica
+{
+
+void *FlightRecorderLogSink::platformMap(size_t size)
+{
+    const HANDLE file = CreateFileA(d.path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                    nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(file == INVALID_HANDLE_VALUE)
+    {
+        return nullptr;
+    }
+    LARGE_INTEGER currentSize;
+    if( GetFileSizeEx(file, &currentSize) && (static_cast<size_t>(currentSize.QuadPart) != size) )
+    {
+        LARGE_INTEGER newSize;
+        newSize.QuadPart = static_cast<LONGLONG>(size);
+        SetFilePointerEx(file, newSize, nullptr, FILE_BEGIN);
+        SetEndOfFile(file);
+    }
+    const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, static_cast<DWORD>(uint64_t(size) >> 32),
+                                              static_cast<DWORD>(size), nullptr);
+    if( ! mapping )
+    {
+        CloseHandle(file);
+        return nullptr;
+    }
+    void *view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if( ! view )
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return nullptr;
+    }
+    d.file = reinterpret_cast<intptr_t>(file);
+    d.mapping = reinterpret_cast<intptr_t>(mapping);
+    d.size = size;
+    return view;
+}
+
+void FlightRecorderLogSink::platformSync()
+{
+    FlushViewOfFile(d.header, d.size);
+    FlushFileBuffers(reinterpret_cast<HANDLE>(d.file));
+}
+
+void FlightRecorderLogSink::platformUnmap()
+{
+    if(d.header)
+    {
+        UnmapViewOfFile(d.header);
+        d.header = nullptr;
+        d.records = nullptr;
+    }
+    if(d.mapping != -1)
+    {
+        CloseHandle(reinterpret_cast<HANDLE>(d.mapping));
+        d.mapping = -1;
+    }
+    if(d.file != -1)
+    {
+        CloseHandle(reinterpret_cast<HANDLE>(d.file));
+        d.file = -1;
+    }
+}
+
+}
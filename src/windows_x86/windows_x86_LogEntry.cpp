@@ -0,0 +1,26 @@
+#include <silica/LogEntry.h>
+
+#include <windows.h>
+
+namespace Silica
+{
+
+uint64_t LogEntry::platformTimestamp()
+{
+    static const uint64_t frequency = [](){
+        LARGE_INTEGER value;
+        QueryPerformanceFrequency(&value);
+        return uint64_t(value.QuadPart);
+    }();
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    const uint64_t ticks = uint64_t(counter.QuadPart);
+    return (ticks / frequency) * 1000000000 + (ticks % frequency) * 1000000000 / frequency;
+}
+
+uint32_t LogEntry::platformThreadId()
+{
+    return GetCurrentThreadId();
+}
+
+}
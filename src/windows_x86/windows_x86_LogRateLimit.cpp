@@ -0,0 +1,13 @@
+#include <silica/LogRateLimit.h>
+
+#include <windows.h>
+
+namespace Silica
+{
+
+uint64_t LogRateLimit::platformMicroseconds()
+{
+    return GetTickCount64() * 1000;
+}
+
+}
@@ -1,32 +1,31 @@
 #include <silica/Mutex.h>
 
+#include <windows.h>
+
 namespace Silica
 {
 
-
-Mutex::Mutex()
-{}
-
-Mutex::~Mutex()
-{}
-
-void Mutex::lock()
+void Mutex::platformWait(int32_t expected)
 {
-    d.mutex.lock();
+    WaitOnAddress(&d.state, &expected, sizeof(expected), INFINITE);
 }
 
-void Mutex::unlock()
+void Mutex::platformWake()
 {
-    d.mutex.unlock();
-
+    WakeByAddressSingle(&d.state);
 }
 
-bool Mutex::tryLock()
+uint64_t Mutex::platformNanoseconds()
 {
-    return d.mutex.try_lock();
+    static const uint64_t ticksPerSecond = [](){
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        return uint64_t(frequency.QuadPart);
+    }();
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    const uint64_t ticks = uint64_t(now.QuadPart);
+    return (ticks / ticksPerSecond) * 1000000000u + ((ticks % ticksPerSecond) * 1000000000u) / ticksPerSecond;
 }
 
-
-};
-
-
+}
@@ -0,0 +1,18 @@
+#include <silica/ReadWriteLock.h>
+
+#include <windows.h>
+
+namespace Silica
+{
+
+void ReadWriteLock::platformWait(int32_t expected)
+{
+    WaitOnAddress(&d.state, &expected, sizeof(expected), INFINITE);
+}
+
+void ReadWriteLock::platformWakeAll()
+{
+    WakeByAddressAll(&d.state);
+}
+
+}
@@ -0,0 +1,38 @@
+#include <silica/Semaphore.h>
+
+#include <windows.h>
+
+namespace Silica
+{
+
+void Semaphore::platformWait(int32_t expected, int64_t timeoutMicroseconds)
+{
+    DWORD milliseconds = INFINITE;
+    if(timeoutMicroseconds >= 0)
+    {
+        milliseconds = static_cast<DWORD>((timeoutMicroseconds + 999) / 1000);
+    }
+    WaitOnAddress(&d.count, &expected, sizeof(expected), milliseconds);
+}
+
+void Semaphore::platformWake(int32_t count)
+{
+    for(int32_t i = 0; i < count; i++)
+    {
+        WakeByAddressSingle(&d.count);
+    }
+}
+
+int64_t Semaphore::platformMicroseconds()
+{
+    static const int64_t ticksPerSecond = [](){
+        LARGE_INTEGER frequency;
+        QueryPerformanceFrequency(&frequency);
+        return int64_t(frequency.QuadPart);
+    }();
+    LARGE_INTEGER now;
+    QueryPerformanceCounter(&now);
+    return (int64_t(now.QuadPart) / ticksPerSecond) * 1000000 + ((int64_t(now.QuadPart) % ticksPerSecond) * 1000000) / ticksPerSecond;
+}
+
+}
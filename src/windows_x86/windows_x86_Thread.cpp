@@ -0,0 +1,61 @@
+#include <silica/Thread.h>
+#include <silica/LoggingSystem.h>
+
+#include <windows.h>
+#include <process.h>
+
+namespace Silica
+{
+
+bool Thread::platformStart()
+{
+    const uintptr_t handle = _beginthreadex(nullptr, static_cast<unsigned>(d.stackSize), [](void *thread) -> unsigned {
+        run(static_cast<Thread*>(thread));
+        return 0;
+    }, this, STACK_SIZE_PARAM_IS_A_RESERVATION, nullptr);
+    if( ! handle )
+    {
+        WARN("Thread not created: %lu", static_cast<unsigned long>(GetLastError()));
+        return false;
+    }
+    d.handle = handle;
+    return true;
+}
+
+void Thread::platformJoin()
+{
+    HANDLE handle = reinterpret_cast<HANDLE>(d.handle);
+    WaitForSingleObject(handle, INFINITE);
+    CloseHandle(handle);
+}
+
+bool Thread::platformConfigureCurrentThread()
+{
+    if(d.name[0])
+    {
+        wchar_t name[nameMaxLength + 1] = {};
+        MultiByteToWideChar(CP_UTF8, 0, d.name, -1, name, nameMaxLength + 1);
+        SetThreadDescription(GetCurrentThread(), name);
+    }
+
+    if(d.affinity)
+    {
+        if( ! SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(d.affinity)) )
+        {
+            WARN("Thread affinity: %lu", static_cast<unsigned long>(GetLastError()));
+            return false;
+        }
+    }
+
+    if(d.realTimePriority > 0)
+    {
+        if( ! SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL) )
+        {
+            WARN("Thread priority: %lu", static_cast<unsigned long>(GetLastError()));
+            return false;
+        }
+    }
+    return true;
+}
+
+}
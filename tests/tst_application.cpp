@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 
 #include <silica/Application.h>
+#include <silica/EventGenerator.h>
+
+#include <thread>
+#include <chrono>
+#include <vector>
 
 #define suiteName tst_application
 
@@ -15,3 +20,196 @@ TEST(suiteName, asdf)
 */
 }
 
+
+
+TEST(suiteName, test_has_instance_only_during_the_lifetime_of_the_application)
+{
+    ASSERT_FALSE(Silica::Application::hasInstance());
+    {
+        Silica::Application app;
+        ASSERT_TRUE(Silica::Application::hasInstance());
+    }
+    ASSERT_FALSE(Silica::Application::hasInstance());
+}
+
+
+
+class CountingEventGenerator : public Silica::EventGenerator
+{
+public:
+    int visits = 0;
+    bool stayAwake = false;
+    int exitOnVisit = -1;
+
+    void visit() override
+    {
+        visits++;
+        if(visits == exitOnVisit)
+        {
+            Silica::Application::instance()->exit(visits);
+        }
+        if(stayAwake)
+        {
+            wake();
+        }
+    }
+};
+
+
+TEST(suiteName, test_only_woken_event_generators_are_visited)
+{
+    Silica::Application app;
+
+    CountingEventGenerator idle;
+    CountingEventGenerator busy;
+    busy.stayAwake = true;
+    busy.exitOnVisit = 100;
+
+    ASSERT_EQ(app.exec(), 100);
+    ASSERT_EQ(idle.visits, 1);
+    ASSERT_EQ(busy.visits, 100);
+}
+
+
+TEST(suiteName, test_wake_from_other_thread_resumes_sleeping_loop)
+{
+    Silica::Application app;
+
+    CountingEventGenerator woken;
+    woken.exitOnVisit = 2;
+
+    std::thread waker([&](){
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        woken.wake();
+    });
+
+    ASSERT_EQ(app.exec(), 2);
+    waker.join();
+}
+
+
+TEST(suiteName, test_destroyed_event_generator_is_removed_from_ready_list)
+{
+    Silica::Application app;
+
+    CountingEventGenerator *doomed = new CountingEventGenerator();
+    CountingEventGenerator survivor;
+    survivor.exitOnVisit = 1;
+    delete doomed;
+
+    ASSERT_EQ(app.exec(), 1);
+}
+
+
+TEST(suiteName, test_registration_is_unbounded_and_unregistration_is_immediate)
+{
+    Silica::Application app;
+
+    constexpr int count = 200;
+    std::vector<CountingEventGenerator*> generators;
+    for(int i = 0; i < count; i++)
+    {
+        generators.push_back(new CountingEventGenerator());
+    }
+    ASSERT_EQ(app.eventGeneratorCount(), count);
+
+    // Remove from the middle, the ends and everything in between.
+    delete generators[count / 2];
+    delete generators.front();
+    delete generators.back();
+    ASSERT_EQ(app.eventGeneratorCount(), count - 3);
+
+    for(int i = 1; i < count - 1; i++)
+    {
+        if(i != count / 2)
+        {
+            delete generators[i];
+        }
+    }
+    ASSERT_EQ(app.eventGeneratorCount(), 0);
+}
+
+
+class SelfDestructingEventGenerator : public CountingEventGenerator
+{
+public:
+    void visit() override
+    {
+        delete victim;
+        victim = nullptr;
+        CountingEventGenerator::visit();
+    }
+    CountingEventGenerator *victim = nullptr;
+};
+
+
+TEST(suiteName, test_event_generators_may_be_destroyed_while_visiting)
+{
+    Silica::Application app;
+
+    SelfDestructingEventGenerator killer;
+    killer.victim = new CountingEventGenerator();
+    killer.victim->exitOnVisit = 1;
+
+    CountingEventGenerator last;
+    last.exitOnVisit = 1;
+
+    ASSERT_EQ(app.exec(), 1);
+    ASSERT_EQ(killer.visits, 1);
+    ASSERT_EQ(app.eventGeneratorCount(), 2);
+}
+
+
+#ifdef SILICA_ENABLE_LOOP_INSTRUMENTATION
+class SleepingEventGenerator : public CountingEventGenerator
+{
+public:
+    std::chrono::microseconds duration{2000};
+
+    void visit() override
+    {
+        std::this_thread::sleep_for(duration);
+        CountingEventGenerator::visit();
+    }
+};
+
+
+TEST(suiteName, test_loop_instrumentation_measures_visits_and_stalls)
+{
+    Silica::Application app;
+
+    SleepingEventGenerator slow;
+    slow.stayAwake = true;
+    slow.exitOnVisit = 5;
+    CountingEventGenerator idle;
+
+    SleepingEventGenerator stalling;
+    stalling.duration = std::chrono::microseconds(SILICA_LOOP_STALL_THRESHOLD + 5000);
+
+    ASSERT_EQ(app.exec(), 5);
+
+    Silica::DurationStatistics visits = slow.visitStatistics();
+    ASSERT_EQ(visits.count, 5);
+    ASSERT_GE(visits.maxMicroseconds, 2000);
+    ASSERT_GE(visits.totalMicroseconds, 5 * 2000);
+    uint64_t histogramTotal = 0;
+    for(uint64_t bucket : visits.histogram)
+    {
+        histogramTotal += bucket;
+    }
+    ASSERT_EQ(histogramTotal, 5);
+    ASSERT_EQ(visits.histogram[Silica::DurationCounters::bucketOf(1)], 0);
+
+    ASSERT_EQ(idle.visitStatistics().count, 1);
+    ASSERT_EQ(stalling.visitStatistics().count, 1);
+
+    Silica::LoopStatistics loop = app.loopStatistics();
+    ASSERT_GE(loop.passes.count, 5);
+    ASSERT_EQ(loop.stalls, 1);
+
+    app.resetLoopStatistics();
+    slow.resetVisitStatistics();
+    ASSERT_EQ(app.loopStatistics().passes.count, 0);
+    ASSERT_EQ(slow.visitStatistics().count, 0);
+}
+#endif
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <silica/Atomic.h>
+#include <silica/RingBuffer.h>
+#include <thread>
+#include <vector>
+
+#define suiteName tst_atomic
+
+namespace
+{
+
+constinit Silica::Atomic<uint32_t> constantInitialized{42};
+
+}
+
+TEST(suiteName, test_operations_return_the_previous_value)
+{
+    ASSERT_EQ(constantInitialized.load(), 42u);
+
+    Silica::Atomic<int32_t> value(5);
+    ASSERT_EQ(value.exchange(7), 5);
+    ASSERT_EQ(value.fetchAdd(3), 7);
+    ASSERT_EQ(value.fetchSub(2, std::memory_order_relaxed), 10);
+    ASSERT_EQ(value.fetchOr(0x10), 8);
+    ASSERT_EQ(value.fetchAnd(0x10), 0x18);
+    ASSERT_EQ(value.load(std::memory_order_acquire), 0x10);
+
+    value.store(-1, std::memory_order_release);
+    ASSERT_EQ(value.load(), -1);
+}
+
+TEST(suiteName, test_compare_exchange_loads_the_current_value_on_failure)
+{
+    int a = 0;
+    int b = 0;
+    Silica::Atomic<int*> pointer(&a);
+
+    int *expected = &b;
+    ASSERT_FALSE(pointer.compareExchange(expected, nullptr));
+    ASSERT_EQ(expected, &a);
+    ASSERT_TRUE(pointer.compareExchange(expected, &b, std::memory_order_acq_rel));
+    ASSERT_EQ(pointer.load(), &b);
+
+    expected = &b;
+    while( ! pointer.compareExchangeWeak(expected, &a, std::memory_order_release) ) {}
+    ASSERT_EQ(pointer.load(), &a);
+}
+
+TEST(suiteName, test_concurrent_increments_are_not_lost)
+{
+    Silica::Atomic<uint64_t> counter;
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&counter](){
+            for(int i = 0; i < 100000; i++)
+            {
+                counter.fetchAdd(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for(std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_EQ(counter.load(), 400000u);
+    ASSERT_TRUE(Silica::Atomic<uint32_t>::isLockFree());
+}
+
+TEST(suiteName, test_ring_buffer_hands_elements_from_one_thread_to_another)
+{
+    Silica::RingBuffer<uint32_t, 16> buffer;
+    buffer.setOverflowPolicy(Silica::OverflowPolicy::SkipNewData);
+    constexpr uint32_t count = 100000;
+
+    std::thread producer([&buffer](){
+        for(uint32_t i = 1; i <= count; i++)
+        {
+            while( ! buffer.push(i) )
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 1;
+    while(expected <= count)
+    {
+        if(buffer.size() == 0)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        ASSERT_EQ(buffer.peek(), expected);
+        ASSERT_TRUE(buffer.pop());
+        expected++;
+    }
+    producer.join();
+    ASSERT_EQ(buffer.size(), 0u);
+}
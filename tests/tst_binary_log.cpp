@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+
+#include <silica/BinaryLog.h>
+#include <BinaryLogDecoder.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define suiteName tst_binary_log
+
+namespace
+{
+
+enum class Color { Red, Green };
+
+std::string decode(FILE *file, size_t *entryCount, bool *isValid)
+{
+    rewind(file);
+    FILE *text = tmpfile();
+    *isValid = Silica::decodeBinaryLog(file, text, entryCount);
+    rewind(text);
+    std::string result;
+    char line[256];
+    while(fgets(line, sizeof(line), text))
+    {
+        result += line;
+    }
+    fclose(text);
+    return result;
+}
+
+}
+
+TEST(suiteName, test_type_tags_of_arguments)
+{
+    using Tags = decltype(Silica::binaryLogTypeTagsOf(1, 2u, 3.0, "text", (void*)nullptr, Color::Green, int8_t(4)));
+    ASSERT_STREQ(Tags::value, "iufspii");
+    ASSERT_STREQ(decltype(Silica::binaryLogTypeTagsOf())::value, "");
+}
+
+TEST(suiteName, test_entries_are_decoded_to_text)
+{
+    FILE *file = tmpfile();
+    Silica::BinaryLog::drain(file); // Discard whatever earlier tests recorded
+
+    const char *name = "gateway";
+    for(int i = 0; i < 3; i++)
+    {
+        LOG_BINARY("entry %d of %s", i, name);
+    }
+    WARN_BINARY("%5.2f%% at %#x, %lu, %c", 99.5, 255u, 7ul, 'z');
+    LOG_BINARY("no arguments");
+    Silica::BinaryLog::drain(file);
+
+    size_t entryCount = 0;
+    bool isValid = false;
+    const std::string text = decode(file, &entryCount, &isValid);
+    fclose(file);
+
+    ASSERT_TRUE(isValid);
+    ASSERT_EQ(entryCount, 5u);
+    ASSERT_NE(text.find("entry 0 of gateway\n"), std::string::npos);
+    ASSERT_NE(text.find("entry 2 of gateway\n"), std::string::npos);
+    ASSERT_NE(text.find("# W : "), std::string::npos);
+    ASSERT_NE(text.find("99.50% at 0xff, 7, z\n"), std::string::npos);
+    ASSERT_NE(text.find("tst_binary_log.cpp : no arguments\n"), std::string::npos);
+}
+
+TEST(suiteName, test_sites_are_written_once_per_file)
+{
+    FILE *file = tmpfile();
+    Silica::BinaryLog::drain(file, true);
+    const long afterFirstDrain = ftell(file);
+
+    for(int i = 0; i < 2; i++)
+    {
+        LOG_BINARY("repeated %d", i);
+        Silica::BinaryLog::drain(file);
+    }
+    const long afterSecondDrain = ftell(file);
+    Silica::BinaryLog::drain(file);
+    ASSERT_EQ(ftell(file) - afterSecondDrain, 5); // Only magic and end tag
+
+    size_t entryCount = 0;
+    bool isValid = false;
+    const std::string text = decode(file, &entryCount, &isValid);
+    fclose(file);
+    ASSERT_GT(afterSecondDrain, afterFirstDrain);
+    ASSERT_TRUE(isValid);
+    ASSERT_EQ(entryCount, 2u);
+    ASSERT_NE(text.find("repeated 1\n"), std::string::npos);
+}
+
+TEST(suiteName, test_full_buffer_drops_records)
+{
+    FILE *file = tmpfile();
+    Silica::BinaryLog::drain(file);
+    const uint64_t droppedBefore = Silica::BinaryLog::droppedRecords();
+
+    const int recordSize = Silica::BinaryLog::recordHeaderSize + 8;
+    const int fitting = SILICA_BINARY_LOG_BUFFER_SIZE / recordSize;
+    for(int i = 0; i < fitting + 10; i++)
+    {
+        LOG_BINARY("%d", i);
+    }
+    ASSERT_EQ(Silica::BinaryLog::droppedRecords() - droppedBefore, 10u);
+    fclose(file);
+}
+
+TEST(suiteName, test_recording_from_threads_while_draining)
+{
+    FILE *file = tmpfile();
+    Silica::BinaryLog::drain(file);
+
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([t](){
+            for(int i = 0; i < 1000; i++)
+            {
+                LOG_BINARY("thread %d entry %d", t, i);
+            }
+        });
+    }
+    for(int i = 0; i < 20; i++)
+    {
+        Silica::BinaryLog::drain(file);
+    }
+    for(std::thread &thread : threads)
+    {
+        thread.join();
+    }
+    Silica::BinaryLog::drain(file);
+
+    size_t entryCount = 0;
+    bool isValid = false;
+    decode(file, &entryCount, &isValid);
+    fclose(file);
+    ASSERT_TRUE(isValid);
+    ASSERT_GT(entryCount, 0u);
+    ASSERT_LE(entryCount, 4000u);
+}
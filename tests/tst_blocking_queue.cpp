@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <silica/BlockingQueue.h>
+
+#include <chrono>
+#include <thread>
+
+using namespace std::chrono;
+
+#define suiteName tst_blocking_queue
+
+
+TEST(suiteName, test_push_and_pop_in_order)
+{
+    Silica::BlockingQueue<int, 4> queue;
+    queue.push(1);
+    queue.push(2);
+    queue.push(3);
+
+    ASSERT_EQ(queue.size(), 3);
+    ASSERT_EQ(queue.pop(), 1);
+    ASSERT_EQ(queue.pop(), 2);
+    ASSERT_EQ(queue.pop(), 3);
+    ASSERT_EQ(queue.size(), 0);
+}
+
+
+TEST(suiteName, test_pop_for_times_out_on_empty_queue)
+{
+    Silica::BlockingQueue<int> queue;
+    int value = -1;
+
+    auto start = steady_clock::now();
+    ASSERT_FALSE(queue.popFor(value, 50'000_us));
+    auto elapsed = duration_cast<milliseconds>(steady_clock::now() - start);
+
+    EXPECT_GE(elapsed.count(), 45);
+    ASSERT_EQ(value, -1);
+}
+
+
+TEST(suiteName, test_pop_wakes_when_other_thread_pushes)
+{
+    Silica::BlockingQueue<int> queue;
+
+    std::thread producer([&](){
+        std::this_thread::sleep_for(milliseconds(20));
+        queue.push(117);
+    });
+
+    int value = 0;
+    ASSERT_TRUE(queue.popFor(value, 5'000'000_us));
+    ASSERT_EQ(value, 117);
+    producer.join();
+}
+
+
+TEST(suiteName, test_drain_to_takes_everything_available)
+{
+    Silica::BlockingQueue<int> queue;
+    for(int i = 0; i < 5; i++)
+    {
+        queue.push(i);
+    }
+
+    Silica::Array<int> destination;
+    ASSERT_EQ(queue.drainTo(destination), 5);
+    ASSERT_EQ(destination.size(), 5);
+    for(int i = 0; i < 5; i++)
+    {
+        ASSERT_EQ(destination[i], i);
+    }
+    ASSERT_EQ(queue.size(), 0);
+}
+
+
+TEST(suiteName, test_drain_to_static_array_leaves_the_rest_in_queue)
+{
+    Silica::BlockingQueue<int> queue;
+    for(int i = 0; i < 5; i++)
+    {
+        queue.push(i);
+    }
+
+    Silica::Array<int, 3> destination;
+    ASSERT_EQ(queue.drainTo(destination), 3);
+    ASSERT_EQ(queue.size(), 2);
+    ASSERT_EQ(queue.pop(), 3);
+    ASSERT_EQ(queue.pop(), 4);
+}
+
+
+TEST(suiteName, test_bounded_queue_with_multiple_producers_and_consumers)
+{
+    constexpr int producerCount = 4;
+    constexpr int elementsPerProducer = 10'000;
+    Silica::BlockingQueue<int, 16> queue;
+
+    std::atomic<long long> sum{0};
+    std::atomic<int> received{0};
+
+    std::vector<std::thread> threads;
+    for(int p = 0; p < producerCount; p++)
+    {
+        threads.emplace_back([&](){
+            for(int i = 1; i <= elementsPerProducer; i++)
+            {
+                queue.push(i);
+            }
+        });
+    }
+    for(int c = 0; c < 2; c++)
+    {
+        threads.emplace_back([&](){
+            int value;
+            while(queue.popFor(value, 200'000_us))
+            {
+                sum += value;
+                received++;
+            }
+        });
+    }
+    for(auto &t : threads)
+    {
+        t.join();
+    }
+
+    ASSERT_EQ(received.load(), producerCount * elementsPerProducer);
+    ASSERT_EQ(sum.load(), (long long)producerCount * elementsPerProducer * (elementsPerProducer + 1) / 2);
+}
@@ -109,3 +109,39 @@ TEST(suiteName, test_repeated_timer)
 }
 
 
+
+
+class VisitCountingTimer : public Silica::CoarseTimer
+{
+public:
+    int visits = 0;
+
+protected:
+    void visit() override
+    {
+        visits++;
+        Silica::CoarseTimer::visit();
+    }
+};
+
+TEST(suiteName, test_stopped_timer_is_not_visited)
+{
+    Silica::Application app;
+
+    VisitCountingTimer stopped;
+    stopped.setTimeout(10'000_us);
+    stopped.start();
+    stopped.stop();
+
+    Silica::CoarseTimer exitTimer;
+    exitTimer.triggered.connectTo([&]()
+    {
+        app.exit(27);
+    });
+    exitTimer.setTimeout(50'000_us);
+    exitTimer.start();
+
+    ASSERT_EQ(app.exec(), 27);
+    // Only the visit of the wake up every EventGenerator gets when it is created
+    ASSERT_EQ(stopped.visits, 1);
+}
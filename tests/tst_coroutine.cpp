@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <silica/Application.h>
+#include <silica/ByteBuffer.h>
+#include <silica/CoarseTimer.h>
+#include <silica/Coroutine.h>
+
+#include <chrono>
+#include <ctime>
+#include <string>
+
+using namespace std::chrono;
+
+#define suiteName tst_coroutine
+
+
+Silica::Coroutine waitForSignalThenExit(Silica::Signal<int> &trigger, std::string &trace)
+{
+    trace += "started ";
+    int value = co_await trigger;
+    trace += "got " + std::to_string(value);
+    Silica::Application::instance()->exit(value);
+}
+
+TEST(suiteName, test_await_signal_with_single_argument)
+{
+    Silica::Application app;
+    Silica::Signal<int> trigger;
+    std::string trace;
+
+    waitForSignalThenExit(trigger, trace);
+    ASSERT_EQ(trace, "started ");
+
+    Silica::CoarseTimer timer;
+    timer.triggered.connectTo([&](){ emit trigger(17); });
+    timer.setTimeout(10'000_us);
+    timer.start();
+
+    ASSERT_EQ(app.exec(), 17);
+    ASSERT_EQ(trace, "started got 17");
+}
+
+
+Silica::Coroutine waitForTuple(Silica::Signal<int, double> &trigger, double &result)
+{
+    auto [a, b] = co_await trigger;
+    result = a * b;
+    Silica::Application::instance()->exit(0);
+}
+
+TEST(suiteName, test_await_signal_with_several_arguments_resumes_on_loop)
+{
+    Silica::Application app;
+    Silica::Signal<int, double> trigger;
+    double result = 0;
+
+    waitForTuple(trigger, result);
+    emit trigger(2, 1.5);
+    ASSERT_EQ(result, 0); // Not resumed from within the emission.
+
+    ASSERT_EQ(app.exec(), 0);
+    ASSERT_EQ(result, 3.0);
+}
+
+
+Silica::Coroutine sleepTwice(int &steps)
+{
+    co_await Silica::sleepFor(50'000_us);
+    steps++;
+    co_await Silica::sleepFor(50'000_us);
+    steps++;
+    Silica::Application::instance()->exit(steps);
+}
+
+TEST(suiteName, test_sleep_for)
+{
+    Silica::Application app;
+    int steps = 0;
+
+    auto start = steady_clock::now();
+    std::clock_t cpuStart = std::clock();
+    sleepTwice(steps);
+    ASSERT_EQ(app.exec(), 2);
+    auto elapsed = duration_cast<milliseconds>(steady_clock::now() - start);
+    double cpuMilliseconds = 1000.0 * double(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+
+    EXPECT_GE(elapsed.count(), 100);
+    EXPECT_LT(elapsed.count(), 300);
+    EXPECT_LT(cpuMilliseconds, 50.0); // The loop sleeps until the deadline rather than polling the clock.
+}
+
+
+Silica::Coroutine addAfterSleep(int value, int &total)
+{
+    co_await Silica::sleepFor(10'000_us);
+    total += value;
+}
+
+Silica::Coroutine addTwiceThenExit(int &total, std::string &trace)
+{
+    co_await addAfterSleep(1, total);
+    trace += std::to_string(total) + " ";
+    Silica::Coroutine second = addAfterSleep(2, total);
+    co_await second;
+    trace += std::to_string(total) + " ";
+    co_await addAfterSleep(0, total);
+    Silica::Application::instance()->exit(total);
+}
+
+TEST(suiteName, test_await_coroutine)
+{
+    Silica::Application app;
+    int total = 0;
+    std::string trace;
+
+    Silica::Coroutine outer = addTwiceThenExit(total, trace);
+    ASSERT_FALSE(outer.isFinished());
+    ASSERT_EQ(app.exec(), 3);
+    ASSERT_EQ(trace, "1 3 ");
+    ASSERT_TRUE(outer.isFinished());
+}
+
+
+Silica::Coroutine readWhenReadable(Silica::IODevice &device, size_t &available)
+{
+    available = co_await Silica::readable(device);
+    Silica::Application::instance()->exit(1);
+}
+
+TEST(suiteName, test_readable_device)
+{
+    Silica::Application app;
+    Silica::Array<Silica::Byte> data = {'a', 'b', 'c'};
+    Silica::ByteBuffer device(&data);
+    size_t available = 0;
+
+    readWhenReadable(device, available);
+    ASSERT_EQ(app.exec(), 1);
+    ASSERT_EQ(available, 3);
+}
+
+TEST(suiteName, test_device_becoming_readable)
+{
+    Silica::Application app;
+    Silica::Array<Silica::Byte> data;
+    Silica::ByteBuffer device(&data);
+    size_t available = 0;
+
+    readWhenReadable(device, available);
+    ASSERT_EQ(available, 0);
+
+    Silica::CoarseTimer timer;
+    timer.setTimeout(10'000_us);
+    timer.triggered.connectTo([&](){ data.append('x'); timer.stop(); });
+    timer.start();
+
+    ASSERT_EQ(app.exec(), 1);
+    ASSERT_EQ(available, 1);
+}
+
+
+Silica::Coroutine awaitOnce(Silica::Signal<> &trigger, int &count)
+{
+    co_await trigger;
+    count++;
+}
+
+TEST(suiteName, test_frames_are_recycled)
+{
+    Silica::Application app;
+    Silica::Signal<> trigger;
+    int count = 0;
+
+    awaitOnce(trigger, count);
+    emit trigger();
+    app.invokeOnLoop([&](){ app.exit(0); });
+    app.exec();
+    ASSERT_EQ(count, 1);
+
+    const size_t heapAllocations = Silica::CoroutineFrameAllocator::heapAllocationCount();
+    for(int i = 0; i < 10; i++)
+    {
+        awaitOnce(trigger, count);
+        emit trigger();
+        app.invokeOnLoop([&](){ app.exit(0); });
+        app.exec();
+    }
+    ASSERT_EQ(count, 11);
+    ASSERT_EQ(Silica::CoroutineFrameAllocator::heapAllocationCount(), heapAllocations);
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+
+#include <silica/FileLogSink.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#define suiteName tst_file_log_sink
+
+namespace
+{
+
+std::string temporaryPath(const char *name)
+{
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+    for(int i = 0; i < 5; i++)
+    {
+        std::filesystem::remove(path.string() + (i ? "." + std::to_string(i) : std::string()));
+    }
+    return path.string();
+}
+
+size_t lineCount(const std::string &path)
+{
+    std::ifstream file(path);
+    std::string line;
+    size_t count = 0;
+    while(std::getline(file, line))
+    {
+        count++;
+    }
+    return count;
+}
+
+void sink(Silica::FileLogSink &fileSink, const char *message)
+{
+    const Silica::LogEntry entry(__LINE__, __FILE__, message);
+    const Silica::LogRecord record(entry);
+    fileSink.sinkRecord(record);
+}
+
+}
+
+TEST(suiteName, test_entries_are_written_in_one_batch_on_flush)
+{
+    const std::string path = temporaryPath("tst_file_log_sink_batch.log");
+    {
+        Silica::FileLogSink fileSink(path.c_str());
+        ASSERT_TRUE(fileSink.isOpen());
+        fileSink.setFlushDelay(Silica::MilliSeconds(60000));
+
+        for(int i = 0; i < 100; i++)
+        {
+            sink(fileSink, "entry");
+        }
+        ASSERT_EQ(fileSink.writeCalls(), 0u);
+        ASSERT_EQ(lineCount(path), 0u);
+
+        fileSink.flush();
+        ASSERT_EQ(fileSink.writeCalls(), 1u);
+        ASSERT_EQ(lineCount(path), 100u);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST(suiteName, test_full_buffer_is_written_without_flush)
+{
+    const std::string path = temporaryPath("tst_file_log_sink_full.log");
+    Silica::FileLogSink fileSink(path.c_str());
+    fileSink.setFlushDelay(Silica::MilliSeconds(60000));
+
+    const Silica::LogEntry entry(__LINE__, __FILE__, "entry");
+    const size_t entries = 2 * SILICA_FILE_LOG_SINK_CHUNKS * SILICA_FILE_LOG_SINK_CHUNK_SIZE / Silica::LogRecord(entry).textLength();
+    for(size_t i = 0; i < entries; i++)
+    {
+        sink(fileSink, "entry");
+    }
+    ASSERT_GE(fileSink.writeCalls(), 1u);
+    ASSERT_LT(fileSink.writeCalls(), 10u);
+    fileSink.flush();
+    ASSERT_EQ(lineCount(path), entries);
+    std::filesystem::remove(path);
+}
+
+TEST(suiteName, test_zero_delay_writes_every_entry)
+{
+    const std::string path = temporaryPath("tst_file_log_sink_delay.log");
+    Silica::FileLogSink fileSink(path.c_str());
+    fileSink.setFlushDelay(Silica::MilliSeconds(0));
+    sink(fileSink, "one");
+    sink(fileSink, "two");
+    ASSERT_EQ(fileSink.writeCalls(), 2u);
+    ASSERT_EQ(lineCount(path), 2u);
+    std::filesystem::remove(path);
+}
+
+TEST(suiteName, test_files_are_rotated_by_size)
+{
+    const std::string path = temporaryPath("tst_file_log_sink_rotate.log");
+    {
+        Silica::FileLogSink fileSink(path.c_str());
+        fileSink.setMaximumFileSize(500);
+        fileSink.setMaximumFiles(2);
+        fileSink.setSyncPolicy(Silica::FileLogSink::SyncPolicy::OnRotation);
+        for(int i = 0; i < 100; i++)
+        {
+            sink(fileSink, "rotating");
+            fileSink.flush();
+        }
+    }
+    ASSERT_TRUE(std::filesystem::exists(path));
+    ASSERT_TRUE(std::filesystem::exists(path + ".1"));
+    ASSERT_TRUE(std::filesystem::exists(path + ".2"));
+    ASSERT_FALSE(std::filesystem::exists(path + ".3"));
+    ASSERT_LE(std::filesystem::file_size(path + ".1"), 500u + Silica::LogRecord::textMaxLength);
+    for(const char *suffix : {"", ".1", ".2"})
+    {
+        std::filesystem::remove(path + suffix);
+    }
+}
+
+TEST(suiteName, test_logging_system_flush_writes_the_file)
+{
+    const std::string path = temporaryPath("tst_file_log_sink_system.log");
+    Silica::FileLogSink fileSink(path.c_str());
+    fileSink.setFlushDelay(Silica::MilliSeconds(60000));
+    Silica::LoggingSystem *loggingSystem = Silica::LoggingSystem::instance();
+    loggingSystem->setSink(&fileSink);
+
+    LOG("first");
+    WARN("second");
+    ASSERT_EQ(lineCount(path), 0u);
+    loggingSystem->flush();
+    ASSERT_EQ(lineCount(path), 2u);
+
+    loggingSystem->setSink(nullptr);
+    std::filesystem::remove(path);
+}
+
+TEST(suiteName, test_json_lines_format)
+{
+    const std::string path = temporaryPath("tst_file_log_sink_json.log");
+    {
+        Silica::FileLogSink fileSink(path.c_str());
+        fileSink.setFormat(Silica::FileLogSink::Format::JsonLines);
+        Silica::LogEntry entry(7, "Gateway.cpp");
+        entry.setTimestamp(5);
+        entry.setThreadId(3);
+        Silica::LogFields::encode(entry, "bytes", 512);
+        const Silica::LogRecord record(entry);
+        fileSink.sinkRecord(record);
+    }
+    std::ifstream file(path);
+    std::string line;
+    ASSERT_TRUE(std::getline(file, line));
+    ASSERT_EQ(line, "{\"type\":\"L\",\"time\":5,\"thread\":3,\"line\":7,\"file\":\"Gateway.cpp\",\"message\":\"\",\"bytes\":512}");
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include <silica/FlightRecorderLogSink.h>
+#include <silica/LoggingSystem.h>
+#include <FlightRecorderReader.h>
+#include <filesystem>
+#include <string>
+
+#ifdef SILICA_OS_LINUX
+#include <stdlib.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <thread>
+#endif
+
+#define suiteName tst_flight_recorder
+
+namespace
+{
+
+std::string temporaryPath(const char *name)
+{
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove(path);
+    return path.string();
+}
+
+void record(Silica::FlightRecorderLogSink &sink, int number)
+{
+    Silica::LogEntry entry(__LINE__, __FILE__);
+    entry.format("entry %d", number);
+    entry.setType(Silica::LogEntry::Type::Warning);
+    sink.sinkEntry(entry);
+}
+
+std::string read(const std::string &path, size_t *entryCount)
+{
+    FILE *input = fopen(path.c_str(), "rb");
+    FILE *text = tmpfile();
+    const bool isValid = Silica::readFlightRecorder(input, text, entryCount);
+    fclose(input);
+    std::string result = isValid ? "" : "INVALID";
+    rewind(text);
+    char line[256];
+    while(fgets(line, sizeof(line), text))
+    {
+        result += line;
+    }
+    fclose(text);
+    return result;
+}
+
+}
+
+TEST(suiteName, test_records_are_read_in_order_after_wrapping)
+{
+    const std::string path = temporaryPath("tst_flight_recorder_wrap.flight");
+    {
+        Silica::FlightRecorderLogSink sink(path.c_str(), 8);
+        ASSERT_TRUE(sink.isOpen());
+        for(int i = 0; i < 20; i++)
+        {
+            record(sink, i);
+        }
+        ASSERT_EQ(sink.recordedEntries(), 20u);
+    }
+
+    size_t entryCount = 0;
+    const std::string text = read(path, &entryCount);
+    ASSERT_EQ(entryCount, 8u);
+    ASSERT_EQ(text.find("entry 11"), std::string::npos);
+    const size_t first = text.find("entry 12");
+    const size_t last = text.find("entry 19");
+    ASSERT_NE(first, std::string::npos);
+    ASSERT_NE(last, std::string::npos);
+    ASSERT_LT(first, last);
+    ASSERT_NE(text.find("# W : "), std::string::npos);
+    std::filesystem::remove(path);
+}
+
+TEST(suiteName, test_recording_continues_in_the_same_file)
+{
+    const std::string path = temporaryPath("tst_flight_recorder_continue.flight");
+    {
+        Silica::FlightRecorderLogSink sink(path.c_str(), 8);
+        record(sink, 1);
+        record(sink, 2);
+    }
+    {
+        Silica::FlightRecorderLogSink sink(path.c_str(), 8);
+        ASSERT_EQ(sink.recordedEntries(), 2u);
+        record(sink, 3);
+    }
+    {
+        Silica::FlightRecorderLogSink sink(path.c_str(), 16); // Other geometry, starts over
+        ASSERT_EQ(sink.recordedEntries(), 0u);
+    }
+    size_t entryCount = 1;
+    read(path, &entryCount);
+    ASSERT_EQ(entryCount, 0u);
+    std::filesystem::remove(path);
+}
+
+TEST(suiteName, test_reader_rejects_other_files)
+{
+    const std::string path = temporaryPath("tst_flight_recorder_other.flight");
+    FILE *file = fopen(path.c_str(), "wb");
+    fputs("not a flight recorder", file);
+    fclose(file);
+    size_t entryCount = 0;
+    ASSERT_EQ(read(path, &entryCount), "INVALID");
+    std::filesystem::remove(path);
+}
+
+#ifdef SILICA_OS_LINUX
+TEST(suiteName, test_records_survive_a_crash)
+{
+    const std::string path = temporaryPath("tst_flight_recorder_crash.flight");
+    const pid_t child = fork();
+    if(child == 0)
+    {
+        Silica::FlightRecorderLogSink sink(path.c_str(), 64);
+        for(int i = 0; i < 10; i++)
+        {
+            record(sink, i);
+        }
+        abort();
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    ASSERT_TRUE(WIFSIGNALED(status));
+
+    size_t entryCount = 0;
+    const std::string text = read(path, &entryCount);
+    ASSERT_EQ(entryCount, 10u);
+    ASSERT_NE(text.find("entry 9"), std::string::npos);
+    std::filesystem::remove(path);
+}
+#endif
+
+#ifdef SILICA_OS_LINUX
+namespace
+{
+
+/* Never returns, so the writer thread delivers nothing once it reaches the sink. */
+class StuckSink : public Silica::LogSink
+{
+public:
+    void sinkEntry(const Silica::LogEntry &) override
+    {
+        for(;;)
+        {
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+        }
+    }
+};
+
+}
+
+TEST(suiteName, test_staged_entries_survive_a_crash)
+{
+    const std::string path = temporaryPath("tst_flight_recorder_staged.flight");
+    const pid_t child = fork();
+    if(child == 0)
+    {
+        StuckSink stuck;
+        Silica::FlightRecorderLogSink sink(path.c_str(), 64);
+        Silica::LoggingSystem *loggingSystem = Silica::LoggingSystem::instance();
+        loggingSystem->setSink(&stuck);
+        loggingSystem->addSink(&sink);
+        loggingSystem->startAsynchronous();
+        for(int i = 0; i < 10; i++)
+        {
+            WARN("entry %d", i);
+        }
+        abort();
+    }
+    int status = 0;
+    waitpid(child, &status, 0);
+    ASSERT_TRUE(WIFSIGNALED(status));
+
+    size_t entryCount = 0;
+    const std::string text = read(path, &entryCount);
+    ASSERT_EQ(entryCount, 10u);
+    ASSERT_NE(text.find("entry 9"), std::string::npos);
+    std::filesystem::remove(path);
+}
+#endif
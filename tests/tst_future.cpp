@@ -0,0 +1,229 @@
+#include <gtest/gtest.h>
+
+#include <silica/Application.h>
+#include <silica/Future.h>
+#include <silica/ThreadPool.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+
+#define suiteName tst_future
+
+
+TEST(suiteName, test_then_runs_on_the_loop)
+{
+    Silica::Application app;
+    Silica::Promise<int> promise;
+    Silica::Future<int> future = promise.future();
+    ASSERT_TRUE(future.isValid());
+    ASSERT_FALSE(future.isReady());
+
+    int result = 0;
+    future.then([&result](int &value){ result = value; Silica::Application::instance()->exit(0); });
+    ASSERT_FALSE(future.isValid());
+
+    promise.setValue(42);
+    ASSERT_EQ(result, 0); // Not called from within setValue().
+
+    app.exec();
+    ASSERT_EQ(result, 42);
+}
+
+
+TEST(suiteName, test_then_on_ready_future_and_chaining)
+{
+    Silica::Application app;
+    Silica::Promise<int> promise;
+    Silica::Future<int> future = promise.future();
+    promise.setValue(20);
+    ASSERT_TRUE(future.isReady());
+    ASSERT_EQ(future.value(), 20);
+
+    std::string result;
+    future.then([](int &value){ return value + 1; })
+          .then([](int &value){ return std::to_string(value); })
+          .then([&result](std::string &value){ result = value; })
+          .then([](){ Silica::Application::instance()->exit(0); });
+    ASSERT_TRUE(result.empty());
+
+    app.exec();
+    ASSERT_EQ(result, "21");
+}
+
+
+TEST(suiteName, test_promise_fulfilled_from_thread_pool)
+{
+    Silica::Application app;
+    Silica::ThreadPool pool(4);
+
+    int result = 0;
+    for(int i = 1; i <= 10; i++)
+    {
+        Silica::Promise<int> promise;
+        Silica::Future<int> future = promise.future();
+        app.post([promise = std::move(promise), i]() mutable { promise.setValue(i * i); });
+        future.then([&result](int &value){
+            result += value;
+            if(result == 385)
+            {
+                Silica::Application::instance()->exit(0);
+            }
+        });
+    }
+
+    app.exec();
+    ASSERT_EQ(result, 385);
+}
+
+
+TEST(suiteName, test_when_all_and_when_any)
+{
+    Silica::Application app;
+    Silica::Promise<int> first;
+    Silica::Promise<double> second;
+    Silica::Promise<int> third;
+    Silica::Promise<int> fourth;
+
+    std::tuple<int, double> all;
+    std::pair<size_t, int> any;
+    int continuations = 0;
+
+    Silica::whenAll(first.future(), second.future()).then([&](std::tuple<int, double> &values){
+        all = values;
+        continuations++;
+    });
+    Silica::whenAny(third.future(), fourth.future()).then([&](std::pair<size_t, int> &value){
+        any = value;
+        continuations++;
+    });
+
+    int continuationsBeforeFirst = -1;
+    second.setValue(2.5);
+    fourth.setValue(4);
+    // Each continuation is queued on the loop, so give every step a pass of its own.
+    app.invokeOnLoop([&](){
+        app.invokeOnLoop([&](){
+            continuationsBeforeFirst = continuations;
+            first.setValue(1);
+            third.setValue(3);
+            app.invokeOnLoop([&](){
+                app.invokeOnLoop([&](){ app.exit(0); });
+            });
+        });
+    });
+
+    app.exec();
+    ASSERT_EQ(continuationsBeforeFirst, 1); // whenAny was done, whenAll still waited for the first.
+    ASSERT_EQ(continuations, 2);
+    ASSERT_EQ(std::get<0>(all), 1);
+    ASSERT_EQ(std::get<1>(all), 2.5);
+    ASSERT_EQ(any.first, 1);
+    ASSERT_EQ(any.second, 4);
+}
+
+
+Silica::Coroutine awaitFutures(Silica::Future<int> first, Silica::Future<void> second, int &result)
+{
+    result = co_await first;
+    co_await second;
+    result++;
+    Silica::Application::instance()->exit(result);
+}
+
+TEST(suiteName, test_await_future)
+{
+    Silica::Application app;
+    Silica::Promise<int> first;
+    Silica::Promise<void> second;
+    int result = 0;
+
+    awaitFutures(first.future(), second.future(), result);
+    app.invokeOnLoop([&](){ first.setValue(6); });
+    app.invokeOnLoop([&](){ second.setValue(); });
+
+    ASSERT_EQ(app.exec(), 7);
+    ASSERT_EQ(result, 7);
+}
+
+
+TEST(suiteName, test_broken_promise_releases_continuation)
+{
+    Silica::Application app;
+    std::shared_ptr<int> tracker = std::make_shared<int>(0);
+    bool called = false;
+
+    Silica::Future<int> chained;
+    {
+        Silica::Promise<int> promise;
+        Silica::Future<int> future = promise.future();
+        chained = future.then([tracker, &called](int &value){ called = true; return value; });
+        ASSERT_EQ(tracker.use_count(), 2);
+    }
+    ASSERT_EQ(tracker.use_count(), 1);
+    ASSERT_TRUE(chained.isBroken());
+    ASSERT_FALSE(chained.isReady());
+
+    app.invokeOnLoop([&](){ app.exit(0); });
+    app.exec();
+    ASSERT_FALSE(called);
+}
+
+
+TEST(suiteName, test_shared_state_is_recycled)
+{
+    Silica::Application app;
+    auto roundTrip = [&app](){
+        Silica::Promise<int> promise;
+        promise.future().then([](int &){});
+        promise.setValue(1);
+        app.invokeOnLoop([&app](){ app.exit(0); });
+        app.exec();
+    };
+
+    roundTrip();
+    const size_t heapAllocations = Silica::CoroutineFrameAllocator::heapAllocationCount();
+    for(int i = 0; i < 100; i++) // More than the frames earlier tests left in the loop thread's own pool
+    {
+        roundTrip();
+    }
+    ASSERT_EQ(Silica::CoroutineFrameAllocator::heapAllocationCount(), heapAllocations);
+}
+
+TEST(suiteName, test_shared_state_released_on_a_worker_is_recycled)
+{
+    Silica::Application app;
+    Silica::ThreadPool pool(1);
+    auto roundTrip = [&app](){
+        std::atomic<bool> isLoopDone{false};
+        std::atomic<bool> isReleased{false};
+        Silica::Promise<int> promise;
+        promise.future().then([&app](int &){ app.exit(0); });
+        app.post([promise = std::move(promise), &isLoopDone, &isReleased]() mutable {
+            promise.setValue(1);
+            while(!isLoopDone)
+            {
+                std::this_thread::yield();
+            }
+            {
+                Silica::Promise<int> last = std::move(promise); // Releases the last reference here, on the worker
+            }
+            isReleased = true;
+        });
+        app.exec();
+        isLoopDone = true;
+        while(!isReleased)
+        {
+            std::this_thread::yield();
+        }
+    };
+
+    roundTrip();
+    const size_t heapAllocations = Silica::CoroutineFrameAllocator::heapAllocationCount();
+    for(int i = 0; i < 10; i++)
+    {
+        roundTrip();
+    }
+    ASSERT_EQ(Silica::CoroutineFrameAllocator::heapAllocationCount(), heapAllocations);
+}
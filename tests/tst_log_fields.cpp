@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <silica/LogFields.h>
+#include <silica/LogRecord.h>
+#include <string>
+#include <vector>
+
+#define suiteName tst_log_fields
+
+namespace
+{
+
+enum class Color : int8_t
+{
+    Red = -2
+};
+
+class RecordingSink : public Silica::LogSink
+{
+public:
+    void sinkRecord(const Silica::LogRecord &record) override
+    {
+        lines.push_back(record.text());
+        fieldsSizes.push_back(record.entry().fieldsSize());
+    }
+
+    std::vector<std::string> lines;
+    std::vector<size_t> fieldsSizes;
+};
+
+}
+
+TEST(suiteName, test_fields_are_read_back_with_their_types)
+{
+    Silica::LogEntry entry;
+    Silica::LogFields::encode(entry, "conn", 3, "d", -70000, "b", uint64_t(1) << 40, "r", 0.5, "ok", true, "p", "gw", "c", Color::Red);
+    // Small integers take a single byte
+    ASSERT_LT(entry.fieldsSize(), 64u);
+
+    Silica::LogFields::Reader reader(entry);
+    Silica::LogFields::Field field;
+    ASSERT_TRUE(reader.next(field));
+    ASSERT_EQ(std::string(field.key, field.keyLength), "conn");
+    ASSERT_EQ(field.type, Silica::LogFields::Type::Signed);
+    ASSERT_EQ(field.signedValue, 3);
+    ASSERT_TRUE(reader.next(field));
+    ASSERT_EQ(field.signedValue, -70000);
+    ASSERT_TRUE(reader.next(field));
+    ASSERT_EQ(field.type, Silica::LogFields::Type::Unsigned);
+    ASSERT_EQ(field.unsignedValue, uint64_t(1) << 40);
+    ASSERT_TRUE(reader.next(field));
+    ASSERT_EQ(field.type, Silica::LogFields::Type::FloatingPoint);
+    ASSERT_EQ(field.floatingPointValue, 0.5);
+    ASSERT_TRUE(reader.next(field));
+    ASSERT_EQ(field.type, Silica::LogFields::Type::Boolean);
+    ASSERT_TRUE(field.booleanValue);
+    ASSERT_TRUE(reader.next(field));
+    ASSERT_EQ(field.type, Silica::LogFields::Type::String);
+    ASSERT_EQ(std::string(field.stringValue, field.stringLength), "gw");
+    ASSERT_TRUE(reader.next(field));
+    ASSERT_EQ(field.signedValue, -2);
+    ASSERT_FALSE(reader.next(field));
+}
+
+TEST(suiteName, test_fields_not_fitting_are_left_out_completely)
+{
+    const std::string longValue(SILICA_LOGENTRY_FIELDS_MAX_SIZE, 'x');
+    Silica::LogEntry entry;
+    Silica::LogFields::encode(entry, "a", 1, "long", longValue.c_str(), "b", 2);
+
+    char text[64];
+    Silica::LogFields::appendText(entry, text, sizeof(text));
+    ASSERT_STREQ(text, "a=1");
+}
+
+TEST(suiteName, test_text_and_json_rendering)
+{
+    Silica::LogEntry entry(42, "Gateway.cpp");
+    entry.setTimestamp(1000);
+    entry.setThreadId(7);
+    Silica::LogFields::encode(entry, "conn", 3, "peer", "a\"b", "ok", false);
+
+    const Silica::LogRecord record(entry);
+    ASSERT_STREQ(record.text(), "# L :   42 : Gateway.cpp     : conn=3 peer=\"a\"b\" ok=false\n");
+
+    char json[Silica::LogFields::jsonMaxLength + 1];
+    Silica::LogFields::renderJson(entry, json, sizeof(json));
+    ASSERT_STREQ(json, "{\"type\":\"L\",\"time\":1000,\"thread\":7,\"line\":42,\"file\":\"Gateway.cpp\",\"message\":\"\",\"conn\":3,\"peer\":\"a\\\"b\",\"ok\":false}");
+
+    char shortJson[8];
+    ASSERT_EQ(Silica::LogFields::renderJson(entry, shortJson, sizeof(shortJson)), 7u);
+}
+
+TEST(suiteName, test_log_kv_reaches_the_sinks)
+{
+    RecordingSink sink;
+    Silica::LoggingSystem::instance()->setSink(&sink);
+
+    const int id = 7;
+    LOG_KV("conn", id, "bytes", 512u);
+    WARN_KV("dropped", true);
+
+    ASSERT_EQ(sink.lines.size(), 2u);
+    ASSERT_NE(sink.lines[0].find(": conn=7 bytes=512\n"), std::string::npos);
+    ASSERT_EQ(sink.lines[1].rfind("# W :", 0), 0u);
+    ASSERT_NE(sink.fieldsSizes[1], 0u);
+    Silica::LoggingSystem::instance()->setSink(nullptr);
+}
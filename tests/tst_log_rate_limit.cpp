@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <silica/Array.h>
+#include <silica/LogRateLimit.h>
+#include <string>
+#include <vector>
+
+#define suiteName tst_log_rate_limit
+
+namespace
+{
+
+class RecordingSink : public Silica::LogSink
+{
+public:
+    void sinkEntry(const Silica::LogEntry &entry) override
+    {
+        messages.push_back(entry.message());
+    }
+
+    std::vector<std::string> messages;
+};
+
+bool isRepeat(const std::string &message, const char *count)
+{
+    return message.rfind(std::string("Repeated ") + count, 0) == 0;
+}
+
+}
+
+TEST(suiteName, test_every_n_logs_the_first_and_every_nth)
+{
+    RecordingSink sink;
+    Silica::LoggingSystem::instance()->setSink(&sink);
+
+    for(int i = 0; i < 10; i++)
+    {
+        LOG_EVERY_N(3, "hit %d", i);
+    }
+
+    ASSERT_EQ(sink.messages.size(), 7u);
+    ASSERT_EQ(sink.messages[0], "hit 0");
+    ASSERT_TRUE(isRepeat(sink.messages[1], "2"));
+    ASSERT_EQ(sink.messages[2], "hit 3");
+    ASSERT_EQ(sink.messages[6], "hit 9");
+    Silica::LoggingSystem::instance()->setSink(nullptr);
+}
+
+TEST(suiteName, test_rate_limited_reports_the_repeats_on_flush)
+{
+    RecordingSink sink;
+    Silica::LoggingSystem::instance()->setSink(&sink);
+
+    for(int i = 0; i < 100; i++)
+    {
+        WARN_RATE_LIMITED(5, "hit %d", i);
+    }
+    ASSERT_EQ(sink.messages.size(), 5u);
+    ASSERT_EQ(sink.messages[4], "hit 4");
+
+    Silica::LoggingSystem::instance()->flush();
+    ASSERT_EQ(sink.messages.size(), 6u);
+    ASSERT_TRUE(isRepeat(sink.messages[5], "95"));
+
+    Silica::LoggingSystem::instance()->flush();
+    ASSERT_EQ(sink.messages.size(), 6u);
+    Silica::LoggingSystem::instance()->setSink(nullptr);
+}
+
+TEST(suiteName, test_container_warnings_are_rate_limited)
+{
+    RecordingSink sink;
+    Silica::LoggingSystem::instance()->setSink(&sink);
+
+    Silica::Array<int> array;
+    for(int i = 0; i < 1000; i++)
+    {
+        array[5] = i;
+    }
+    ASSERT_EQ(sink.messages.size(), size_t(SILICA_CONTAINER_WARNINGS_PER_SECOND));
+
+    Silica::LoggingSystem::instance()->flush();
+    ASSERT_EQ(sink.messages.size(), size_t(SILICA_CONTAINER_WARNINGS_PER_SECOND) + 1);
+    ASSERT_TRUE(isRepeat(sink.messages.back(), "990"));
+    Silica::LoggingSystem::instance()->setSink(nullptr);
+}
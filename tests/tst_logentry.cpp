@@ -2,6 +2,7 @@
 
 #include <silica/LoggingSystem.h>
 #include <silica/Application.h>
+#include <string.h>
 
 #define suiteName tst_logentry
 
@@ -69,7 +70,8 @@ TEST(suiteName, test_set_filename_with_no_slashes_at_all)
 TEST(suiteName, test_set_super_long_filename_with_no_slashes_at_all)
 {
     Silica::LogEntry le;
-    le.setOriginatingFile("bongo-bongo-super-long.cpp");
+    static constexpr Silica::SourceFileName fileName("bongo-bongo-super-long.cpp");
+    le.setOriginatingFile(fileName);
     ASSERT_STREQ(le.originatingFile(), "bongo-...ng.cpp");
 }
 
@@ -77,17 +79,46 @@ TEST(suiteName, test_set_super_long_filename_with_no_slashes_at_all)
 TEST(suiteName, test_set_super_long_filename_with_forward_slashes)
 {
     Silica::LogEntry le;
-    le.setOriginatingFile("/for/ward/slashes/bongo-bongo-super-long.cpp");
+    static constexpr Silica::SourceFileName fileName("/for/ward/slashes/bongo-bongo-super-long.cpp");
+    le.setOriginatingFile(fileName);
     ASSERT_STREQ(le.originatingFile(), "bongo-...ng.cpp");
 }
 
 TEST(suiteName, test_set_super_long_filename_with_backward_slashes)
 {
     Silica::LogEntry le;
-    le.setOriginatingFile("c:\\back\\ward\\slashes\\bongo-bongo-super-long.cpp");
+    static constexpr Silica::SourceFileName fileName("c:\\back\\ward\\slashes\\bongo-bongo-super-long.cpp");
+    le.setOriginatingFile(fileName);
+    ASSERT_STREQ(le.originatingFile(), "bongo-...ng.cpp");
+}
+
+TEST(suiteName, test_set_super_long_filename_at_runtime_is_shortened)
+{
+    Silica::LogEntry le;
+    le.setOriginatingFile("/for/ward/slashes/bongo-bongo-super-long.cpp");
     ASSERT_STREQ(le.originatingFile(), "bongo-...ng.cpp");
 }
 
+TEST(suiteName, test_filename_built_at_runtime_is_copied)
+{
+    char path[] = "/built/at/runtime.cpp";
+    Silica::LogEntry le(7, path);
+    const Silica::LogEntry copy = le;
+    memset(path, 'x', sizeof(path) - 1);
+    ASSERT_STREQ(le.originatingFile(), "runtime.cpp");
+    ASSERT_STREQ(copy.originatingFile(), "runtime.cpp");
+    ASSERT_NE(copy.originatingFile(), le.originatingFile());
+}
+
+TEST(suiteName, test_source_file_name_is_shared_static_storage)
+{
+    static_assert(Silica::SourceFileName("/a/b/bongo.cpp").name[5] == '.', "The name is computed at compile time");
+    const Silica::LogEntry first(__LINE__, SILICA_SOURCE_FILE_NAME);
+    const Silica::LogEntry second(__LINE__, SILICA_SOURCE_FILE_NAME);
+    ASSERT_STREQ(first.originatingFile(), "tst_lo...ry.cpp");
+    ASSERT_EQ(first.originatingFile(), second.originatingFile());
+}
+
 TEST(suiteName, test_send_to_application_instance)
 {
 
@@ -0,0 +1,414 @@
+#include <gtest/gtest.h>
+
+#include <silica/LoggingSystem.h>
+#include <atomic>
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define suiteName tst_logging_system
+
+namespace
+{
+
+class RecordingSink : public Silica::LogSink
+{
+public:
+    void sinkEntry(const Silica::LogEntry &entry) override
+    {
+        while(isBlocked.load())
+        {
+            std::this_thread::yield();
+        }
+        messages.push_back(entry.message());
+        files.push_back(entry.originatingFile());
+        threads.push_back(std::this_thread::get_id());
+    }
+
+    void flush() override
+    {
+        flushes++;
+    }
+
+    std::atomic<bool> isBlocked{false};
+    std::vector<std::string> messages;
+    std::vector<std::string> files;
+    std::vector<std::thread::id> threads;
+    size_t flushes = 0;
+};
+
+class TextSink : public Silica::LogSink
+{
+public:
+    void sinkRecord(const Silica::LogRecord &record) override
+    {
+        lines.push_back(record.text());
+        texts.push_back(record.text());
+    }
+
+    void flush() override
+    {
+        flushes++;
+    }
+
+    std::vector<std::string> lines;
+    std::vector<const char*> texts;
+    size_t flushes = 0;
+};
+
+class StampSink : public Silica::LogSink
+{
+public:
+    void sinkEntry(const Silica::LogEntry &entry) override
+    {
+        entries.push_back({entry.timestamp(), entry.threadId(), entry.message()});
+    }
+
+    struct Stamped
+    {
+        uint64_t timestamp;
+        uint32_t threadId;
+        std::string message;
+    };
+
+    std::vector<Stamped> entries;
+};
+
+/* Checks that the entries of each thread arrived in the order logged, with rising timestamps. */
+void verifyPerThreadOrder(const std::vector<StampSink::Stamped> &entries, int threadCount, int entriesPerThread)
+{
+    ASSERT_EQ(entries.size(), size_t(threadCount * entriesPerThread));
+    std::vector<int> nextOfThread(threadCount, 0);
+    std::vector<uint64_t> lastTimestampOfThread(threadCount, 0);
+    std::vector<uint32_t> idOfThread(threadCount, 0);
+    for(const StampSink::Stamped &entry : entries)
+    {
+        int thread = -1;
+        int index = -1;
+        ASSERT_EQ(sscanf(entry.message.c_str(), "t%d e%d", &thread, &index), 2);
+        ASSERT_GE(thread, 0);
+        ASSERT_LT(thread, threadCount);
+        ASSERT_EQ(index, nextOfThread[thread]++);
+        ASSERT_NE(entry.timestamp, 0u);
+        ASSERT_GE(entry.timestamp, lastTimestampOfThread[thread]);
+        lastTimestampOfThread[thread] = entry.timestamp;
+        if(idOfThread[thread] == 0)
+        {
+            idOfThread[thread] = entry.threadId;
+        }
+        ASSERT_EQ(entry.threadId, idOfThread[thread]);
+    }
+    for(int i = 0; i < threadCount; i++)
+    {
+        for(int j = i + 1; j < threadCount; j++)
+        {
+            ASSERT_NE(idOfThread[i], idOfThread[j]);
+        }
+    }
+}
+
+void logFromThreads(int threadCount, int entriesPerThread)
+{
+    std::vector<std::thread> threads;
+    for(int t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([t, entriesPerThread](){
+            for(int i = 0; i < entriesPerThread; i++)
+            {
+                LOG("t%d e%d", t, i);
+            }
+        });
+    }
+    for(std::thread &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+}
+
+TEST(suiteName, test_synchronous_delivery_flushes_every_entry)
+{
+    RecordingSink sink;
+    Silica::LoggingSystem::instance()->setSink(&sink);
+
+    LOG("one");
+    WARN("two");
+
+    ASSERT_EQ(sink.messages.size(), 2u);
+    ASSERT_EQ(sink.messages[1], "two");
+    ASSERT_EQ(sink.threads[0], std::this_thread::get_id());
+    ASSERT_EQ(sink.flushes, 2u);
+    Silica::LoggingSystem::instance()->setSink(nullptr);
+}
+
+TEST(suiteName, test_asynchronous_delivery_happens_on_the_writer_thread)
+{
+    RecordingSink sink;
+    Silica::LoggingSystem *loggingSystem = Silica::LoggingSystem::instance();
+    loggingSystem->setSink(&sink);
+    ASSERT_TRUE(loggingSystem->startAsynchronous());
+    ASSERT_FALSE(loggingSystem->startAsynchronous());
+    ASSERT_TRUE(loggingSystem->isAsynchronous());
+
+    for(int i = 0; i < 100; i++)
+    {
+        LOG("entry %d", i);
+    }
+    loggingSystem->flush();
+
+    ASSERT_EQ(sink.messages.size(), 100u);
+    ASSERT_EQ(sink.messages[42], "entry 42");
+    ASSERT_NE(sink.threads[0], std::this_thread::get_id());
+    ASSERT_LE(sink.flushes, 100u);
+
+    loggingSystem->stopAsynchronous();
+    ASSERT_FALSE(loggingSystem->isAsynchronous());
+    loggingSystem->setSink(nullptr);
+}
+
+TEST(suiteName, test_asynchronous_delivery_keeps_file_names_built_at_runtime)
+{
+    RecordingSink sink;
+    Silica::LoggingSystem *loggingSystem = Silica::LoggingSystem::instance();
+    loggingSystem->setSink(&sink);
+    sink.isBlocked = true;
+    ASSERT_TRUE(loggingSystem->startAsynchronous());
+
+    {
+        std::string path = "/generated/plugin.cpp";
+        Silica::LogEntry entry(3, path.c_str(), "loaded");
+        loggingSystem->sinkEntry(entry);
+        path.assign(path.size(), 'x');
+    }
+    sink.isBlocked = false;
+    loggingSystem->flush();
+
+    ASSERT_EQ(sink.files.size(), 1u);
+    ASSERT_EQ(sink.files[0], "plugin.cpp");
+
+    loggingSystem->stopAsynchronous();
+    loggingSystem->setSink(nullptr);
+}
+
+TEST(suiteName, test_synchronous_sinks_bypass_the_staging_buffers)
+{
+    RecordingSink staged;
+    RecordingSink synchronous;
+    synchronous.setSynchronous(true);
+    Silica::LoggingSystem *loggingSystem = Silica::LoggingSystem::instance();
+    loggingSystem->setSink(&staged);
+    loggingSystem->addSink(&synchronous);
+    staged.isBlocked = true;
+    ASSERT_TRUE(loggingSystem->startAsynchronous());
+
+    LOG("one");
+    LOG("two");
+    ASSERT_EQ(synchronous.messages.size(), 2u);
+    ASSERT_EQ(synchronous.threads[1], std::this_thread::get_id());
+
+    staged.isBlocked = false;
+    loggingSystem->flush();
+    ASSERT_EQ(staged.messages.size(), 2u);
+    ASSERT_EQ(synchronous.messages.size(), 2u);
+
+    loggingSystem->stopAsynchronous();
+    LOG("three");
+    ASSERT_EQ(staged.messages.size(), 3u);
+    ASSERT_EQ(synchronous.messages.size(), 3u);
+    loggingSystem->setSink(nullptr);
+}
+
+TEST(suiteName, test_full_queue_drops_and_reports)
+{
+    RecordingSink sink;
+    Silica::LoggingSystem *loggingSystem = Silica::LoggingSystem::instance();
+    loggingSystem->setSink(&sink);
+    const uint64_t droppedBefore = loggingSystem->droppedEntries();
+    loggingSystem->startAsynchronous(Silica::LoggingSystem::QueuePolicy::Drop);
+
+    sink.isBlocked = true;
+    for(int i = 0; i < SILICA_LOGGING_QUEUE_CAPACITY + 10; i++)
+    {
+        LOG("entry %d", i);
+    }
+    ASSERT_GE(loggingSystem->droppedEntries() - droppedBefore, 9u);
+    sink.isBlocked = false;
+    loggingSystem->stopAsynchronous();
+
+    ASSERT_LT(sink.messages.size(), SILICA_LOGGING_QUEUE_CAPACITY + 10u);
+    ASSERT_NE(sink.messages.back().find("entries"), std::string::npos); // "N entries dropped", elided
+    loggingSystem->setSink(nullptr);
+}
+
+TEST(suiteName, test_full_queue_blocks)
+{
+    RecordingSink sink;
+    Silica::LoggingSystem *loggingSystem = Silica::LoggingSystem::instance();
+    loggingSystem->setSink(&sink);
+    const uint64_t droppedBefore = loggingSystem->droppedEntries();
+    loggingSystem->startAsynchronous(Silica::LoggingSystem::QueuePolicy::Block);
+
+    std::thread producer([](){
+        for(int i = 0; i < 4 * SILICA_LOGGING_QUEUE_CAPACITY; i++)
+        {
+            LOG("entry %d", i);
+        }
+    });
+    producer.join();
+    loggingSystem->flush();
+
+    ASSERT_EQ(sink.messages.size(), 4u * SILICA_LOGGING_QUEUE_CAPACITY);
+    ASSERT_EQ(loggingSystem->droppedEntries(), droppedBefore);
+    loggingSystem->stopAsynchronous();
+    loggingSystem->setSink(nullptr);
+}
+
+TEST(suiteName, test_levels_below_the_threshold_are_not_formatted)
+{
+    RecordingSink sink;
+    Silica::LoggingSystem *loggingSystem = Silica::LoggingSystem::instance();
+    loggingSystem->setSink(&sink);
+
+    int evaluations = 0;
+    LOG_TRACE("trace %d", ++evaluations);
+    LOG_DEBUG("debug %d", ++evaluations);
+    LOG_INFO("info %d", ++evaluations);
+    ASSERT_EQ(evaluations, 1);
+    ASSERT_EQ(sink.messages.size(), 1u);
+
+    loggingSystem->setLevel(Silica::LogEntry::Type::Trace);
+    LOG_TRACE("trace %d", ++evaluations);
+    ASSERT_EQ(evaluations, 2);
+    ASSERT_EQ(sink.messages.back(), "trace 2");
+
+    loggingSystem->setLevel(Silica::LogEntry::Type::Log);
+    LOG_TRACE("trace %d", ++evaluations);
+    ASSERT_EQ(evaluations, 2);
+    loggingSystem->setSink(nullptr);
+}
+
+TEST(suiteName, test_thresholds_per_file_and_category)
+{
+    RecordingSink sink;
+    Silica::LoggingSystem *loggingSystem = Silica::LoggingSystem::instance();
+    loggingSystem->setSink(&sink);
+
+    ASSERT_TRUE(loggingSystem->setLevel("tst_logging_system.cpp", Silica::LogEntry::Type::Warning));
+    ASSERT_TRUE(loggingSystem->setLevel("network", Silica::LogEntry::Type::Debug));
+    ASSERT_EQ(loggingSystem->level("/some/path/tst_logging_system.cpp"), Silica::LogEntry::Type::Warning);
+    ASSERT_EQ(loggingSystem->level("other.cpp"), Silica::LogEntry::Type::Log);
+
+    LOG("suppressed");
+    WARN("warned");
+    LOG_CATEGORY("network", Silica::LogEntry::Type::Debug, "debugged");
+    LOG_CATEGORY("storage", Silica::LogEntry::Type::Debug, "suppressed");
+    ASSERT_EQ(sink.messages.size(), 2u);
+    ASSERT_EQ(sink.messages[0], "warned");
+    ASSERT_EQ(sink.messages[1], "debugged");
+
+    loggingSystem->clearLevels();
+    LOG("logged");
+    ASSERT_EQ(sink.messages.size(), 3u);
+    loggingSystem->setSink(nullptr);
+}
+
+TEST(suiteName, test_entries_fan_out_to_all_sinks_formatted_once)
+{
+    TextSink all;
+    TextSink warnings;
+    Silica::LoggingSystem *loggingSystem = Silica::LoggingSystem::instance();
+    loggingSystem->setSink(&all);
+    ASSERT_TRUE(loggingSystem->addSink(&warnings));
+    ASSERT_FALSE(loggingSystem->addSink(&warnings));
+    warnings.setLevel(Silica::LogEntry::Type::Warning);
+    all.setFlushInterval(3);
+
+    for(int i = 0; i < 4; i++)
+    {
+        LOG("entry %d", i);
+    }
+    WARN("careful");
+
+    ASSERT_EQ(all.lines.size(), 5u);
+    ASSERT_EQ(warnings.lines.size(), 1u);
+    ASSERT_EQ(all.flushes, 1u);
+    ASSERT_EQ(warnings.flushes, 1u);
+    ASSERT_EQ(warnings.texts[0], all.texts[4]); // The very same text
+    ASSERT_NE(all.lines[4].find("# W : "), std::string::npos);
+    ASSERT_NE(all.lines[4].find(" : careful\n"), std::string::npos);
+
+    loggingSystem->flush();
+    ASSERT_EQ(all.flushes, 2u);
+    loggingSystem->flush();
+    ASSERT_EQ(all.flushes, 2u); // Nothing pending
+
+    loggingSystem->removeSink(&warnings);
+    LOG("only one sink left");
+    ASSERT_EQ(warnings.lines.size(), 1u);
+    loggingSystem->setSink(nullptr);
+}
+
+TEST(suiteName, test_entries_are_stamped_with_time_and_thread)
+{
+    StampSink sink;
+    Silica::LoggingSystem::instance()->setSink(&sink);
+
+    LOG("first");
+    LOG("second");
+    std::thread other([](){ LOG("other"); });
+    other.join();
+
+    ASSERT_EQ(sink.entries.size(), 3u);
+    ASSERT_NE(sink.entries[0].timestamp, 0u);
+    ASSERT_LE(sink.entries[0].timestamp, sink.entries[1].timestamp);
+    ASSERT_EQ(sink.entries[0].threadId, sink.entries[1].threadId);
+    ASSERT_NE(sink.entries[0].threadId, sink.entries[2].threadId);
+    Silica::LoggingSystem::instance()->setSink(nullptr);
+}
+
+TEST(suiteName, test_synchronous_logging_from_many_threads)
+{
+    StampSink sink;
+    Silica::LoggingSystem::instance()->setSink(&sink);
+
+    logFromThreads(4, 500);
+
+    verifyPerThreadOrder(sink.entries, 4, 500);
+    Silica::LoggingSystem::instance()->setSink(nullptr);
+}
+
+TEST(suiteName, test_asynchronous_logging_from_many_threads)
+{
+    StampSink sink;
+    Silica::LoggingSystem *loggingSystem = Silica::LoggingSystem::instance();
+    loggingSystem->setSink(&sink);
+    const uint64_t droppedBefore = loggingSystem->droppedEntries();
+    loggingSystem->startAsynchronous(Silica::LoggingSystem::QueuePolicy::Block);
+
+    logFromThreads(4, 4 * SILICA_LOGGING_QUEUE_CAPACITY);
+    loggingSystem->flush();
+
+    verifyPerThreadOrder(sink.entries, 4, 4 * SILICA_LOGGING_QUEUE_CAPACITY);
+    ASSERT_EQ(loggingSystem->droppedEntries(), droppedBefore);
+    loggingSystem->stopAsynchronous();
+    loggingSystem->setSink(nullptr);
+}
+
+TEST(suiteName, test_asynchronous_delivery_flushes_sinks_with_an_interval)
+{
+    TextSink sink;
+    sink.setFlushInterval(1000);
+    Silica::LoggingSystem *loggingSystem = Silica::LoggingSystem::instance();
+    loggingSystem->setSink(&sink);
+    loggingSystem->startAsynchronous();
+
+    LOG("entry");
+    loggingSystem->flush();
+    ASSERT_EQ(sink.lines.size(), 1u);
+    ASSERT_EQ(sink.flushes, 1u);
+
+    loggingSystem->stopAsynchronous();
+    loggingSystem->setSink(nullptr);
+}
@@ -0,0 +1,163 @@
+#include <gtest/gtest.h>
+
+#include <silica/LogFields.h>
+#include <silica/Mutex.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define suiteName tst_mutex
+
+namespace
+{
+
+class RecordingSink : public Silica::LogSink
+{
+public:
+    void sinkRecord(const Silica::LogRecord &record) override
+    {
+        lines.push_back(record.text());
+    }
+
+    std::vector<std::string> lines;
+};
+
+/* Holds \p mutex for \p milliseconds on another thread, and returns once that thread locked it. */
+std::thread holdFor(Silica::Mutex &mutex, int milliseconds)
+{
+    std::atomic<bool> isHeld{false};
+    std::thread holder([&mutex, &isHeld, milliseconds](){
+        Silica::MutexLocker locker(mutex);
+        isHeld = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+    });
+    while( ! isHeld )
+    {
+        std::this_thread::yield();
+    }
+    return holder;
+}
+
+}
+
+TEST(suiteName, test_threads_are_mutually_excluded)
+{
+    Silica::Mutex mutex;
+    uint64_t counter = 0;
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&mutex, &counter](){
+            for(int i = 0; i < 100000; i++)
+            {
+                Silica::MutexLocker locker(mutex);
+                counter++;
+            }
+        });
+    }
+    for(std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    ASSERT_EQ(counter, 400000u);
+#ifdef SILICA_ENABLE_MUTEX_STATISTICS
+    const Silica::MutexStatistics statistics = mutex.statistics();
+    ASSERT_EQ(statistics.acquisitions, 400000u);
+    ASSERT_LE(statistics.contendedAcquisitions, statistics.acquisitions);
+    ASSERT_GE(statistics.totalWaitNanoseconds, statistics.maxWaitNanoseconds);
+#endif
+}
+
+TEST(suiteName, test_try_lock_does_not_block)
+{
+    Silica::Mutex mutex;
+    ASSERT_TRUE(mutex.tryLock());
+    std::thread other([&mutex](){
+        ASSERT_FALSE(mutex.tryLock());
+    });
+    other.join();
+    mutex.unlock();
+
+    std::thread holder = holdFor(mutex, 1);
+    holder.join();
+    ASSERT_TRUE(mutex.tryLock());
+    mutex.unlock();
+#ifdef SILICA_ENABLE_MUTEX_STATISTICS
+    ASSERT_EQ(mutex.statistics().acquisitions, 3u);
+    ASSERT_EQ(mutex.statistics().contendedAcquisitions, 0u);
+#endif
+}
+
+#ifdef SILICA_ENABLE_MUTEX_STATISTICS
+TEST(suiteName, test_waiting_is_measured)
+{
+    Silica::Mutex mutex("contended");
+    std::thread holder = holdFor(mutex, 20);
+    mutex.lock();
+    mutex.unlock();
+    holder.join();
+
+    const Silica::MutexStatistics statistics = mutex.statistics();
+    ASSERT_STREQ(statistics.name, "contended");
+    ASSERT_EQ(statistics.acquisitions, 2u);
+    ASSERT_EQ(statistics.contendedAcquisitions, 1u);
+    ASSERT_GE(statistics.maxWaitNanoseconds, 10000000u);
+    ASSERT_EQ(statistics.totalWaitNanoseconds, statistics.maxWaitNanoseconds);
+
+    mutex.resetStatistics();
+    ASSERT_EQ(mutex.statistics().acquisitions, 0u);
+    ASSERT_EQ(mutex.statistics().maxWaitNanoseconds, 0u);
+}
+
+TEST(suiteName, test_most_contended_mutexes_come_first)
+{
+    Silica::Mutex quiet("quiet");
+    Silica::Mutex little("little");
+    Silica::Mutex much("much");
+    quiet.lock();
+    quiet.unlock();
+    std::thread holder = holdFor(little, 5);
+    little.lock();
+    little.unlock();
+    holder.join();
+    holder = holdFor(much, 30);
+    much.lock();
+    much.unlock();
+    holder.join();
+
+    Silica::MutexStatistics top[2];
+    ASSERT_EQ(Silica::Mutex::mostContended(top, 2), 2u);
+    ASSERT_STREQ(top[0].name, "much");
+    ASSERT_STREQ(top[1].name, "little");
+
+    Silica::MutexStatistics all[64];
+    const size_t count = Silica::Mutex::mostContended(all, 64);
+    for(size_t i = 0; i < count; i++)
+    {
+        ASSERT_STRNE(all[i].name, "quiet");
+    }
+
+    RecordingSink sink;
+    Silica::LoggingSystem::instance()->setSink(&sink);
+    Silica::Mutex::logMostContended(1);
+    Silica::LoggingSystem::instance()->setSink(nullptr);
+    ASSERT_EQ(sink.lines.size(), 1u);
+    ASSERT_NE(sink.lines[0].find("mutex=\"much\" acq=2 cont=1 wait_ns="), std::string::npos);
+}
+#else
+TEST(suiteName, test_statistics_are_zero_without_counters)
+{
+    Silica::Mutex mutex("uncounted");
+    std::thread holder = holdFor(mutex, 5);
+    mutex.lock();
+    mutex.unlock();
+    holder.join();
+
+    ASSERT_EQ(mutex.statistics().acquisitions, 0u);
+    Silica::MutexStatistics top[1];
+    ASSERT_EQ(Silica::Mutex::mostContended(top, 1), 0u);
+}
+#endif
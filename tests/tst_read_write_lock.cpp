@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <silica/ReadWriteLock.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#define suiteName tst_read_write_lock
+
+TEST(suiteName, test_readers_share_and_writers_exclude)
+{
+    Silica::ReadWriteLock lock;
+    ASSERT_TRUE(lock.tryLockForRead());
+    ASSERT_TRUE(lock.tryLockForRead());
+    ASSERT_FALSE(lock.tryLockForWrite());
+    lock.unlockForRead();
+    lock.unlockForRead();
+
+    ASSERT_TRUE(lock.tryLockForWrite());
+    ASSERT_FALSE(lock.tryLockForRead());
+    ASSERT_FALSE(lock.tryLockForWrite());
+    lock.unlockForWrite();
+    ASSERT_TRUE(lock.tryLockForRead());
+    lock.unlockForRead();
+}
+
+TEST(suiteName, test_readers_hold_concurrently)
+{
+    Silica::ReadWriteLock lock;
+    std::atomic<int> inside{0};
+    std::atomic<int> mostInside{0};
+    std::vector<std::thread> readers;
+    for(int t = 0; t < 4; t++)
+    {
+        readers.emplace_back([&](){
+            Silica::ReadLocker locker(lock);
+            const int now = ++inside;
+            int most = mostInside.load();
+            while( (now > most) && ! mostInside.compare_exchange_weak(most, now) ) {}
+            // Waits for the others to come in, which they only can if readers share the lock
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while( (mostInside.load() < 4) && (std::chrono::steady_clock::now() < deadline) )
+            {
+                std::this_thread::yield();
+            }
+            --inside;
+        });
+    }
+    for(std::thread &reader : readers)
+    {
+        reader.join();
+    }
+    ASSERT_EQ(mostInside.load(), 4);
+}
+
+TEST(suiteName, test_a_waiting_writer_holds_back_new_readers)
+{
+    Silica::ReadWriteLock lock;
+    lock.lockForRead();
+    std::atomic<bool> hasWritten{false};
+    std::thread writer([&](){
+        Silica::WriteLocker locker(lock);
+        hasWritten = true;
+    });
+    // Once the writer waits, new readers are turned away
+    while(lock.tryLockForRead())
+    {
+        lock.unlockForRead();
+        std::this_thread::yield();
+    }
+    ASSERT_FALSE(hasWritten.load());
+    lock.unlockForRead();
+    writer.join();
+    ASSERT_TRUE(hasWritten.load());
+    ASSERT_TRUE(lock.tryLockForRead());
+    lock.unlockForRead();
+}
+
+TEST(suiteName, test_readers_see_consistent_data)
+{
+    Silica::ReadWriteLock lock;
+    uint64_t table[4] = {};
+    std::atomic<bool> isDone{false};
+    std::atomic<bool> isTorn{false};
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([&](){
+            while( ! isDone )
+            {
+                Silica::ReadLocker locker(lock);
+                for(int i = 1; i < 4; i++)
+                {
+                    if(table[i] != table[0])
+                    {
+                        isTorn = true;
+                    }
+                }
+            }
+        });
+    }
+    for(int t = 0; t < 2; t++)
+    {
+        threads.emplace_back([&](){
+            for(int n = 0; n < 20000; n++)
+            {
+                Silica::WriteLocker locker(lock);
+                for(int i = 0; i < 4; i++)
+                {
+                    table[i]++;
+                }
+            }
+        });
+    }
+    threads[4].join();
+    threads[5].join();
+    isDone = true;
+    for(int t = 0; t < 4; t++)
+    {
+        threads[t].join();
+    }
+    ASSERT_FALSE(isTorn.load());
+    ASSERT_EQ(table[3], 40000u);
+}
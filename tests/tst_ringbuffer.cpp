@@ -292,3 +292,71 @@ TEST(suiteName, test_set_integrity_maintained_when_T_assignment_operator_throws_
 }
 
 
+
+
+TEST(suiteName, test_dynamic_capacity_grows_and_keeps_order)
+{
+    Silica::RingBuffer<int> rb;
+    ASSERT_EQ(rb.capacity(), 1);
+
+    rb.push(1);
+    rb.push(2);
+    rb.push(3);
+    ASSERT_EQ(rb.size(), 3);
+    ASSERT_EQ(rb.capacity(), 4);
+
+    POP_AND_ASSERT_EQ(1);
+    rb.push(4);
+    rb.push(5);
+    rb.push(6); // Wraps around before growing, which forces a relinearization.
+    ASSERT_EQ(rb.size(), 5);
+    ASSERT_EQ(rb.capacity(), 8);
+
+    POP_AND_ASSERT_EQ(2);
+    POP_AND_ASSERT_EQ(3);
+    POP_AND_ASSERT_EQ(4);
+    POP_AND_ASSERT_EQ(5);
+    POP_AND_ASSERT_EQ(6);
+    ASSERT_EQ(rb.size(), 0);
+    ASSERT_FALSE(rb.pop());
+}
+
+
+TEST(suiteName, test_dynamic_capacity_with_maximum_and_overwrite_policy)
+{
+    Silica::RingBuffer<int, 0> rb;
+    rb.setMaximumCapacity(3);
+    rb.setOverflowPolicy(Silica::OverflowPolicy::OverwriteOldestData);
+
+    for(int i = 1; i <= 9; i++)
+    {
+        ASSERT_TRUE(rb.push(i));
+    }
+
+    ASSERT_EQ(rb.capacity(), 3);
+    ASSERT_EQ(rb.size(), 3);
+    POP_AND_ASSERT_EQ(7);
+    POP_AND_ASSERT_EQ(8);
+    POP_AND_ASSERT_EQ(9);
+    ASSERT_EQ(rb.size(), 0);
+}
+
+
+TEST(suiteName, test_dynamic_capacity_with_maximum_and_skip_new_data_policy)
+{
+    Silica::RingBuffer<int> rb;
+    rb.setMaximumCapacity(3);
+    rb.setOverflowPolicy(Silica::OverflowPolicy::SkipNewData);
+
+    ASSERT_TRUE(rb.push(1));
+    ASSERT_TRUE(rb.push(2));
+    ASSERT_TRUE(rb.push(3));
+    ASSERT_FALSE(rb.push(4));
+    ASSERT_FALSE(rb.push(5));
+
+    ASSERT_EQ(rb.capacity(), 3);
+    ASSERT_EQ(rb.sizeAvailable(), 0);
+    POP_AND_ASSERT_EQ(1);
+    POP_AND_ASSERT_EQ(2);
+    POP_AND_ASSERT_EQ(3);
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#define SILICA_ARRAY_INITIAL_CAPACITY 1
+
+#include <silica/RingBuffer.h>
+
+#ifndef SILICA_ENABLE_RINGBUFFER_STATISTICS
+    #error "The test builds must turn on the SILICA_ENABLE_RINGBUFFER_STATISTICS CMake option."
+#endif
+
+#define suiteName tst_ringbuffer_statistics
+
+
+TEST(suiteName, test_counts_pushes_and_high_water_mark)
+{
+    Silica::RingBuffer<int, 4> rb;
+    rb.push(1);
+    rb.push(2);
+    rb.push(3);
+    rb.pop();
+    rb.pop();
+    rb.push(4);
+
+    const auto statistics = rb.statistics();
+    ASSERT_EQ(statistics.pushes, 4);
+    ASSERT_EQ(statistics.drops, 0);
+    ASSERT_EQ(statistics.overwrites, 0);
+    ASSERT_EQ(statistics.highWaterMark, 3);
+}
+
+
+TEST(suiteName, test_counts_drops_with_skip_new_data_policy)
+{
+    Silica::RingBuffer<int, 2> rb;
+    rb.setOverflowPolicy(Silica::OverflowPolicy::SkipNewData);
+    for(int i = 0; i < 5; i++)
+    {
+        rb.push(i);
+    }
+
+    const auto statistics = rb.statistics();
+    ASSERT_EQ(statistics.pushes, 5);
+    ASSERT_EQ(statistics.drops, 3);
+    ASSERT_EQ(statistics.overwrites, 0);
+    ASSERT_EQ(statistics.highWaterMark, 2);
+}
+
+
+TEST(suiteName, test_counts_overwrites_with_overwrite_oldest_data_policy)
+{
+    Silica::RingBuffer<int, 2> rb;
+    rb.setOverflowPolicy(Silica::OverflowPolicy::OverwriteOldestData);
+    for(int i = 0; i < 5; i++)
+    {
+        rb.push(i);
+    }
+
+    const auto statistics = rb.statistics();
+    ASSERT_EQ(statistics.pushes, 5);
+    ASSERT_EQ(statistics.drops, 0);
+    ASSERT_EQ(statistics.overwrites, 3);
+    ASSERT_EQ(statistics.highWaterMark, 2);
+}
+
+
+TEST(suiteName, test_reset_keeps_current_size_as_high_water_mark)
+{
+    Silica::RingBuffer<int, 4> rb;
+    rb.push(1);
+    rb.push(2);
+    rb.push(3);
+    rb.pop();
+    rb.resetStatistics();
+
+    auto statistics = rb.statistics();
+    ASSERT_EQ(statistics.pushes, 0);
+    ASSERT_EQ(statistics.highWaterMark, 2);
+
+    rb.push(4);
+    rb.push(5);
+    statistics = rb.statistics();
+    ASSERT_EQ(statistics.pushes, 2);
+    ASSERT_EQ(statistics.highWaterMark, 4);
+}
+
+
+TEST(suiteName, test_dynamic_capacity_counts_growth_as_plain_pushes)
+{
+    Silica::RingBuffer<int> rb;
+    rb.setMaximumCapacity(4);
+    rb.setOverflowPolicy(Silica::OverflowPolicy::SkipNewData);
+    for(int i = 0; i < 6; i++)
+    {
+        rb.push(i);
+    }
+
+    const auto statistics = rb.statistics();
+    ASSERT_EQ(statistics.pushes, 6);
+    ASSERT_EQ(statistics.drops, 2);
+    ASSERT_EQ(statistics.highWaterMark, 4);
+}
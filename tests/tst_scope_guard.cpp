@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include <silica/ScopeGuard.h>
+#include <silica/Application.h>
+#include <silica/ByteBuffer.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#define suiteName tst_scope_guard
+
+namespace
+{
+
+std::atomic<size_t> allocationCount{0};
+
+}
+
+// Counts the heap allocations of the whole test program
+void *operator new(size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if(void *memory = std::malloc(size ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept
+{
+    std::free(memory);
+}
+
+
+TEST(suiteName, test_calls_callback_on_scope_exit)
+{
+    int calls = 0;
+    {
+        Silica::ScopeGuard guard([&calls](){ calls++; });
+        ASSERT_EQ(calls, 0);
+    }
+    ASSERT_EQ(calls, 1);
+}
+
+TEST(suiteName, test_dismissed_guard_does_not_call)
+{
+    int calls = 0;
+    {
+        auto guard = Silica::makeScopeGuard([&calls](){ calls++; });
+        guard.dismiss();
+    }
+    ASSERT_EQ(calls, 0);
+}
+
+static int freeFunctionCalls = 0;
+static void countFreeFunctionCall() { freeFunctionCalls++; }
+
+TEST(suiteName, test_takes_function_pointers)
+{
+    freeFunctionCalls = 0;
+    {
+        Silica::ScopeGuard guard(countFreeFunctionCall);
+        auto other = Silica::makeScopeGuard(&countFreeFunctionCall);
+    }
+    ASSERT_EQ(freeFunctionCalls, 2);
+}
+
+TEST(suiteName, test_guard_does_not_allocate)
+{
+    int calls = 0;
+    char padding[64] = {};
+    const size_t before = allocationCount.load();
+    {
+        // Captures more than std::function keeps without allocating
+        auto guard = Silica::makeScopeGuard([&calls, padding](){ calls += 1 + padding[63]; });
+    }
+    ASSERT_EQ(allocationCount.load() - before, 0u);
+    ASSERT_EQ(calls, 1);
+}
+
+TEST(suiteName, test_constructing_application_does_not_allocate)
+{
+    const size_t before = allocationCount.load();
+    {
+        Silica::Application app;
+    }
+    ASSERT_EQ(allocationCount.load() - before, 0u);
+}
+
+TEST(suiteName, test_constructing_io_device_does_not_allocate)
+{
+    Silica::Application app;
+    Silica::Array<Silica::Byte> input;
+    Silica::Array<Silica::Byte> output;
+    const size_t before = allocationCount.load();
+    {
+        Silica::ByteBuffer buffer(&input, &output);
+    }
+    ASSERT_EQ(allocationCount.load() - before, 0u);
+}
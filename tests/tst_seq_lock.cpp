@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <silica/SeqLock.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#define suiteName tst_seq_lock
+
+namespace
+{
+
+struct Route
+{
+    uint32_t address;
+    uint16_t port;
+    uint8_t hops;
+};
+
+struct Snapshot
+{
+    uint64_t values[5];
+};
+
+}
+
+TEST(suiteName, test_load_returns_what_was_stored)
+{
+    Silica::SeqLock<Route> route({1, 2, 3});
+    ASSERT_EQ(route.load().port, 2);
+    ASSERT_EQ(route.version(), 0u);
+
+    route.store({0x0a000001, 8080, 4});
+    const Route current = route.load();
+    ASSERT_EQ(current.address, 0x0a000001u);
+    ASSERT_EQ(current.port, 8080);
+    ASSERT_EQ(current.hops, 4);
+    ASSERT_EQ(route.version(), 1u);
+}
+
+TEST(suiteName, test_readers_never_see_a_torn_value)
+{
+    Silica::SeqLock<Snapshot> snapshot;
+    std::atomic<bool> isDone{false};
+    std::atomic<bool> isTorn{false};
+    std::atomic<uint64_t> reads{0};
+    std::vector<std::thread> threads;
+    for(int t = 0; t < 3; t++)
+    {
+        threads.emplace_back([&](){
+            while( ! isDone )
+            {
+                const Snapshot value = snapshot.load();
+                for(int i = 1; i < 5; i++)
+                {
+                    if(value.values[i] != value.values[0])
+                    {
+                        isTorn = true;
+                    }
+                }
+                reads++;
+            }
+        });
+    }
+    for(int t = 0; t < 2; t++)
+    {
+        threads.emplace_back([&, t](){
+            for(uint64_t n = 1; n <= 20000; n++)
+            {
+                const uint64_t v = n * 2 + t;
+                snapshot.store({{v, v, v, v, v}});
+            }
+        });
+    }
+    threads[3].join();
+    threads[4].join();
+    isDone = true;
+    for(int t = 0; t < 3; t++)
+    {
+        threads[t].join();
+    }
+    ASSERT_FALSE(isTorn.load());
+    ASSERT_GT(reads.load(), 0u);
+    ASSERT_EQ(snapshot.version(), 40000u);
+}
@@ -93,7 +93,7 @@ class MySlotOwner
 public:
 
     MySlotOwner()
-        : printNewInt(std::bind(&MySlotOwner::doPrintNextImpl, this, std::placeholders::_1))
+        : printNewInt(Slot<int>::fromMethod<&MySlotOwner::doPrintNextImpl>(this))
     {
     }
 
@@ -122,6 +122,53 @@ TEST(suiteName, test_signal_to_slot_to_class_instance)
 }
 
 
+class BaseSlotOwner
+{
+public:
+    BaseSlotOwner()
+        : take(Slot<int>::fromMethod<&BaseSlotOwner::takeImplementation>(this))
+    {
+    }
+    virtual ~BaseSlotOwner() = default;
+
+    Slot<int> take;
+    int caught = 0;
+
+protected:
+    virtual void takeImplementation(int i) { caught = i; }
+};
+
+class DerivedSlotOwner : public BaseSlotOwner
+{
+protected:
+    void takeImplementation(int i) override { caught = -i; }
+};
+
+TEST(suiteName, test_slot_from_method_dispatches_virtually)
+{
+    Signal<int> emitNewInt;
+    BaseSlotOwner base;
+    DerivedSlotOwner derived;
+    emitNewInt.connectTo(&base.take);
+    emitNewInt.connectTo(&derived.take);
+
+    emitNewInt(5);
+    ASSERT_EQ(base.caught, 5);
+    ASSERT_EQ(derived.caught, -5);
+}
+
+TEST(suiteName, test_slot_with_lambda)
+{
+    int caught = 0;
+    Signal<int> emitNewInt;
+    Slot<int> watcher([&caught](int i){ caught = i; });
+    emitNewInt.connectTo(&watcher);
+
+    emitNewInt(42);
+    ASSERT_EQ(caught, 42);
+}
+
+
 
 
 
@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+
+#include <silica/Application.h>
+#include <silica/Thread.h>
+#include <atomic>
+#include <string>
+#include <thread>
+
+#include <pthread.h>
+#include <sched.h>
+
+#define suiteName tst_thread
+
+namespace
+{
+
+int firstAllowedCpu()
+{
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    sched_getaffinity(0, sizeof(cpus), &cpus);
+    for(int cpu = 0; cpu < 64; cpu++)
+    {
+        if(CPU_ISSET(cpu, &cpus))
+        {
+            return cpu;
+        }
+    }
+    return -1;
+}
+
+}
+
+TEST(suiteName, test_runs_the_task_with_name_and_stack_size)
+{
+    Silica::Thread thread;
+    thread.setName("a-rather-long-thread-name");
+    ASSERT_STREQ(thread.name(), "a-rather-long-t");
+    thread.setStackSize(4 * 1024 * 1024);
+
+    std::string name;
+    size_t stackSize = 0;
+    std::thread::id id;
+    ASSERT_TRUE(thread.start([&](){
+        char buffer[32] = {};
+        pthread_getname_np(pthread_self(), buffer, sizeof(buffer));
+        name = buffer;
+        pthread_attr_t attributes;
+        pthread_getattr_np(pthread_self(), &attributes);
+        pthread_attr_getstacksize(&attributes, &stackSize);
+        pthread_attr_destroy(&attributes);
+        id = std::this_thread::get_id();
+    }));
+    ASSERT_TRUE(thread.isJoinable());
+    ASSERT_FALSE(thread.start([](){}));
+    thread.join();
+    ASSERT_FALSE(thread.isJoinable());
+
+    ASSERT_EQ(name, "a-rather-long-t");
+    ASSERT_GE(stackSize, 4u * 1024 * 1024);
+    ASSERT_NE(id, std::this_thread::get_id());
+}
+
+TEST(suiteName, test_affinity_pins_the_thread)
+{
+    const int cpu = firstAllowedCpu();
+    ASSERT_GE(cpu, 0);
+
+    Silica::Thread thread;
+    thread.setAffinity(uint64_t(1) << cpu);
+    int ranOn = -1;
+    int allowedCount = 0;
+    ASSERT_TRUE(thread.start([&](){
+        ranOn = sched_getcpu();
+        cpu_set_t cpus;
+        sched_getaffinity(0, sizeof(cpus), &cpus);
+        allowedCount = CPU_COUNT(&cpus);
+    }));
+    thread.join();
+    ASSERT_EQ(ranOn, cpu);
+    ASSERT_EQ(allowedCount, 1);
+}
+
+TEST(suiteName, test_settings_that_cannot_be_applied_keep_the_task_from_running)
+{
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    sched_getaffinity(0, sizeof(cpus), &cpus);
+    if(CPU_COUNT(&cpus) >= 64)
+    {
+        GTEST_SKIP() << "Every CPU of the mask is allowed";
+    }
+    int unavailable = 0;
+    while(CPU_ISSET(unavailable, &cpus))
+    {
+        unavailable++;
+    }
+
+    Silica::Thread thread;
+    thread.setAffinity(uint64_t(1) << unavailable);
+    bool hasRun = false;
+    ASSERT_FALSE(thread.start([&hasRun](){ hasRun = true; }));
+    ASSERT_FALSE(hasRun);
+    ASSERT_FALSE(thread.isJoinable());
+}
+
+TEST(suiteName, test_real_time_priority_is_applied_or_refused)
+{
+    Silica::Thread thread;
+    thread.setRealTimePriority(10);
+    int policy = -1;
+    int priority = -1;
+    const bool isStarted = thread.start([&](){
+        struct sched_param parameters;
+        pthread_getschedparam(pthread_self(), &policy, &parameters);
+        priority = parameters.sched_priority;
+    });
+    thread.join();
+    if(isStarted)
+    {
+        ASSERT_EQ(policy, SCHED_FIFO);
+        ASSERT_EQ(priority, 10);
+    }
+    else
+    {
+        // Without CAP_SYS_NICE, the task must not run with normal priority instead
+        ASSERT_EQ(policy, -1);
+    }
+}
+
+TEST(suiteName, test_hosts_the_event_loop)
+{
+    Silica::Application app;
+    Silica::Thread loopThread;
+    loopThread.setName("event-loop");
+
+    std::atomic<bool> hasRunOnLoop{false};
+    std::thread::id loopId;
+    int exitCode = -1;
+    ASSERT_TRUE(loopThread.start([&](){ exitCode = app.exec(); }));
+    app.invokeOnLoop([&](){
+        loopId = std::this_thread::get_id();
+        hasRunOnLoop = true;
+        app.exit(3);
+    });
+    loopThread.join();
+
+    ASSERT_TRUE(hasRunOnLoop.load());
+    ASSERT_NE(loopId, std::this_thread::get_id());
+    ASSERT_EQ(exitCode, 3);
+}
@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+
+#include <silica/Application.h>
+#include <silica/ThreadPool.h>
+#include <silica/SignalSlot.h>
+
+#include <atomic>
+#include <thread>
+
+#define suiteName tst_thread_pool
+
+
+TEST(suiteName, test_task_holds_lambda_and_moves)
+{
+    int counter = 0;
+    Silica::Task task([&counter](){ counter++; });
+    ASSERT_TRUE(bool(task));
+
+    Silica::Task moved(std::move(task));
+    ASSERT_FALSE(bool(task));
+    moved();
+    moved();
+    ASSERT_EQ(counter, 2);
+
+    moved.reset();
+    ASSERT_FALSE(bool(moved));
+    moved();
+    ASSERT_EQ(counter, 2);
+}
+
+
+TEST(suiteName, test_task_deque_pushes_and_pops_at_both_ends)
+{
+    Silica::TaskDeque deque;
+    int last = 0;
+    for(int i = 1; i <= 40; i++)
+    {
+        deque.pushBack([&last, i](){ last = i; });
+    }
+    ASSERT_EQ(deque.size(), 40);
+
+    Silica::Task task;
+    ASSERT_TRUE(deque.popFront(task));
+    task();
+    ASSERT_EQ(last, 1);
+
+    ASSERT_TRUE(deque.popBack(task));
+    task();
+    ASSERT_EQ(last, 40);
+    ASSERT_EQ(deque.size(), 38);
+}
+
+
+TEST(suiteName, test_posted_tasks_all_run)
+{
+    Silica::Application app;
+    std::atomic<int> counter{0};
+    {
+        Silica::ThreadPool pool(4);
+        ASSERT_EQ(pool.workerCount(), 4);
+        for(int i = 0; i < 10'000; i++)
+        {
+            ASSERT_TRUE(app.post([&counter](){ counter++; }));
+        }
+    }
+    ASSERT_EQ(counter.load(), 10'000);
+}
+
+
+TEST(suiteName, test_tasks_posting_subtasks_are_all_run)
+{
+    Silica::Application app;
+    std::atomic<int> counter{0};
+    {
+        Silica::ThreadPool pool(4);
+        for(int i = 0; i < 100; i++)
+        {
+            app.post([&counter, &app](){
+                for(int j = 0; j < 100; j++)
+                {
+                    app.post([&counter](){ counter++; });
+                }
+            });
+        }
+    }
+    ASSERT_EQ(counter.load(), 100 * 100);
+}
+
+
+TEST(suiteName, test_post_without_pool_fails)
+{
+    Silica::Application app;
+    ASSERT_FALSE(app.post([](){}));
+}
+
+
+TEST(suiteName, test_run_async_delivers_result_on_loop_thread)
+{
+    Silica::Application app;
+    Silica::ThreadPool pool(2);
+
+    const auto loopThread = std::this_thread::get_id();
+    std::thread::id workThread;
+    std::thread::id deliveryThread;
+
+    Silica::Signal<int> answerReady;
+    answerReady.connectTo([&](int answer){
+        deliveryThread = std::this_thread::get_id();
+        app.exit(answer);
+    });
+
+    app.runAsync([&](){
+        workThread = std::this_thread::get_id();
+        return 42;
+    }, &answerReady);
+
+    ASSERT_EQ(app.exec(), 42);
+    ASSERT_NE(workThread, loopThread);
+    ASSERT_EQ(deliveryThread, loopThread);
+}
+
+
+TEST(suiteName, test_run_async_without_result)
+{
+    Silica::Application app;
+    Silica::ThreadPool pool(2);
+
+    std::atomic<bool> worked{false};
+    Silica::Signal<> done;
+    done.connectTo([&](){
+        app.exit(worked ? 1 : 2);
+    });
+
+    app.runAsync([&](){ worked = true; }, &done);
+    ASSERT_EQ(app.exec(), 1);
+}
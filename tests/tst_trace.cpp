@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+
+#include <silica/Application.h>
+#include <silica/CoarseTimer.h>
+#include <silica/SignalSlot.h>
+#include <silica/Trace.h>
+
+#include <atomic>
+#include <stdio.h>
+#include <string>
+#include <thread>
+
+#define suiteName tst_trace
+
+
+static std::string writeTrace(size_t &written)
+{
+    FILE *file = tmpfile();
+    written = Silica::Trace::writeChromeTrace(file);
+    std::string content(size_t(ftell(file)), '\0');
+    rewind(file);
+    content.resize(fread(&content[0], 1, content.size(), file));
+    fclose(file);
+    return content;
+}
+
+static size_t occurrences(const std::string &text, const std::string &pattern)
+{
+    size_t count = 0;
+    for(size_t position = text.find(pattern); position != std::string::npos; position = text.find(pattern, position + 1))
+    {
+        count++;
+    }
+    return count;
+}
+
+
+TEST(suiteName, test_records_loop_activity_as_chrome_trace)
+{
+    Silica::Application app;
+    Silica::Signal<> relay;
+    relay.connectTo([&app](){ app.exit(0); });
+
+    Silica::CoarseTimer timer;
+    timer.setTimeout(1'000_us);
+    timer.triggered.connectTo(&relay);
+    timer.start();
+
+    Silica::Trace::start();
+    app.exec();
+    Silica::Trace::stop();
+
+    size_t written = 0;
+    std::string trace = writeTrace(written);
+    ASSERT_EQ(trace.rfind("{\"traceEvents\":[", 0), 0);
+    ASSERT_GT(written, 0);
+    for(const char *name : {"Application::pass", "EventGenerator::visit", "CoarseTimer::triggered", "Signal::emit", "Connection::invoke"})
+    {
+        ASSERT_GT(occurrences(trace, std::string("\"name\":\"") + name + "\""), 0) << name;
+    }
+    ASSERT_EQ(occurrences(trace, "\"ph\":\"B\""), occurrences(trace, "\"ph\":\"E\""));
+    ASSERT_EQ(occurrences(trace, "\"ph\":"), written);
+
+    // Writing consumes the events.
+    writeTrace(written);
+    ASSERT_EQ(written, 0);
+}
+
+
+TEST(suiteName, test_nothing_is_recorded_when_stopped)
+{
+    Silica::Application app;
+    Silica::Signal<> signal;
+    int calls = 0;
+    signal.connectTo([&calls](){ calls++; });
+
+    Silica::Trace::start();
+    Silica::Trace::stop();
+    emit signal();
+    Silica::Trace::instant("ignored");
+
+    size_t written = 0;
+    writeTrace(written);
+    ASSERT_EQ(written, 0);
+    ASSERT_EQ(calls, 1);
+}
+
+
+TEST(suiteName, test_threads_record_into_their_own_buffers)
+{
+    Silica::Application app;
+
+    Silica::Trace::start();
+    Silica::Trace::instant("main");
+    std::thread worker([](){
+        Silica::TraceScope scope("worker");
+    });
+    worker.join();
+    Silica::Trace::stop();
+
+    size_t written = 0;
+    std::string trace = writeTrace(written);
+    ASSERT_EQ(written, 3);
+    ASSERT_EQ(occurrences(trace, "\"name\":\"worker\""), 2);
+    ASSERT_EQ(occurrences(trace, "\"s\":\"t\""), 1);
+
+    size_t mainTid = trace.find("\"tid\":", trace.find("\"name\":\"main\""));
+    size_t workerTid = trace.find("\"tid\":", trace.find("\"name\":\"worker\""));
+    ASSERT_NE(trace.substr(mainTid, 8), trace.substr(workerTid, 8));
+}
+
+
+TEST(suiteName, test_nothing_is_recorded_without_application)
+{
+    Silica::Trace::start();
+    Silica::Trace::instant("orphan");
+    Silica::Trace::stop();
+
+    size_t written = 0;
+    std::string trace = writeTrace(written);
+    ASSERT_EQ(written, 0);
+    ASSERT_EQ(occurrences(trace, "orphan"), 0);
+}
+
+TEST(suiteName, test_full_buffer_keeps_the_oldest_events)
+{
+    Silica::Application app;
+
+    Silica::Trace::start();
+    Silica::Trace::instant("first");
+    for(int i = 0; i < SILICA_TRACE_EVENTS_PER_THREAD; i++)
+    {
+        Silica::Trace::instant("filler");
+    }
+    Silica::Trace::stop();
+
+    size_t written = 0;
+    std::string trace = writeTrace(written);
+    ASSERT_LE(written, size_t(SILICA_TRACE_EVENTS_PER_THREAD));
+    ASSERT_EQ(occurrences(trace, "\"name\":\"first\""), 1);
+}
+
+TEST(suiteName, test_writing_while_recording)
+{
+    Silica::Application app;
+
+    Silica::Trace::start();
+    std::atomic<bool> isDone{false};
+    std::thread worker([&isDone](){
+        for(int i = 0; i < 20000; i++)
+        {
+            Silica::Trace::instant("worker");
+        }
+        isDone = true;
+    });
+    size_t total = 0;
+    while( ! isDone )
+    {
+        size_t written = 0;
+        std::string trace = writeTrace(written);
+        ASSERT_EQ(occurrences(trace, "\"name\":\"worker\""), written);
+        total += written;
+    }
+    worker.join();
+    Silica::Trace::stop();
+    size_t written = 0;
+    writeTrace(written);
+    total += written;
+    ASSERT_LE(total, 20000u);
+    ASSERT_GT(total, 0u);
+}
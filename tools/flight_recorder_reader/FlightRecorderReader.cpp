@@ -0,0 +1,95 @@
+#include "FlightRecorderReader.h"
+#include <silica/FlightRecorderLogSink.h>
+#include <silica/LogRecord.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace Silica
+{
+
+namespace
+{
+
+struct ReadRecord
+{
+    uint64_t sequence;
+    uint32_t line;
+    uint8_t type;
+    std::string file;
+    std::string message;
+};
+
+/* The fields are read from the bytes of the file, whatever the geometry the recording program was built with. */
+std::string fixedString(const uint8_t *data, size_t capacity)
+{
+    const void *end = memchr(data, 0, capacity);
+    return std::string(reinterpret_cast<const char*>(data), end ? static_cast<const uint8_t*>(end) - data : capacity);
+}
+
+}
+
+bool readFlightRecorder(FILE *input, FILE *output, size_t *entryCount)
+{
+    if(entryCount)
+    {
+        *entryCount = 0;
+    }
+
+    uint8_t header[FlightRecorderLogSink::headerSize];
+    if(fread(header, sizeof(header), 1, input) != 1)
+    {
+        return false;
+    }
+    char magic[4];
+    uint32_t version, recordCount, recordSize, fileNameLength, messageLength;
+    memcpy(magic, header + offsetof(FlightRecorderHeader, magic), sizeof(magic));
+    memcpy(&version, header + offsetof(FlightRecorderHeader, version), sizeof(version));
+    memcpy(&recordCount, header + offsetof(FlightRecorderHeader, recordCount), sizeof(recordCount));
+    memcpy(&recordSize, header + offsetof(FlightRecorderHeader, recordSize), sizeof(recordSize));
+    memcpy(&fileNameLength, header + offsetof(FlightRecorderHeader, fileNameLength), sizeof(fileNameLength));
+    memcpy(&messageLength, header + offsetof(FlightRecorderHeader, messageLength), sizeof(messageLength));
+    if( (memcmp(magic, FlightRecorderLogSink::magic, sizeof(magic)) != 0)
+        || (version != FlightRecorderLogSink::version)
+        || (recordSize != FlightRecorderLogSink::recordSize(fileNameLength, messageLength)) )
+    {
+        return false;
+    }
+
+    std::vector<ReadRecord> records;
+    std::vector<uint8_t> data(recordSize);
+    for(uint32_t i = 0; i < recordCount; i++)
+    {
+        if(fread(data.data(), recordSize, 1, input) != 1)
+        {
+            return false;
+        }
+        ReadRecord record;
+        memcpy(&record.sequence, data.data() + offsetof(FlightRecord, sequence), sizeof(record.sequence));
+        if(record.sequence == 0)
+        {
+            continue; // Empty, or torn by a crash
+        }
+        memcpy(&record.line, data.data() + offsetof(FlightRecord, line), sizeof(record.line));
+        memcpy(&record.type, data.data() + offsetof(FlightRecord, type), sizeof(record.type));
+        record.file = fixedString(data.data() + sizeof(FlightRecord), fileNameLength + 1);
+        record.message = fixedString(data.data() + sizeof(FlightRecord) + fileNameLength + 1, messageLength + 1);
+        records.push_back(record);
+    }
+
+    std::sort(records.begin(), records.end(), [](const ReadRecord &a, const ReadRecord &b){ return a.sequence < b.sequence; });
+    for(const ReadRecord &record : records)
+    {
+        fprintf(output, "%10llu # %c : %4u : %-*s : %s\n", static_cast<unsigned long long>(record.sequence - 1),
+                LogRecord::indicatorOf(static_cast<LogEntry::Type>(record.type)), record.line,
+                static_cast<int>(fileNameLength), record.file.c_str(), record.message.c_str());
+    }
+    if(entryCount)
+    {
+        *entryCount = records.size();
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,21 @@
+#ifndef SILICA_FLIGHT_RECORDER_READER_H
+#define SILICA_FLIGHT_RECORDER_READER_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+namespace Silica
+{
+
+/** \brief Reads a file written by Silica::FlightRecorderLogSink from \p input, and writes its records to \p output, oldest first.
+
+The lines look like those of the default LogSink, preceded by the sequence number of the record.
+
+\param entryCount If not null, receives the number of records written.
+\returns True if \p input is a flight recorder file, false if not, or if it is truncated.
+*/
+bool readFlightRecorder(FILE *input, FILE *output, size_t *entryCount = nullptr);
+
+}
+
+#endif // SILICA_FLIGHT_RECORDER_READER_H
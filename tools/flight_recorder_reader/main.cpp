@@ -0,0 +1,31 @@
+#include "FlightRecorderReader.h"
+
+/*
+ * silica_flight_recorder_reader file
+ *
+ * Prints the records a Silica::FlightRecorderLogSink left in file, oldest
+ * first, e.g. after the program crashed.
+ */
+int main(int argc, char **argv)
+{
+    if(argc != 2)
+    {
+        fprintf(stderr, "usage: silica_flight_recorder_reader file\n");
+        return 2;
+    }
+    FILE *input = fopen(argv[1], "rb");
+    if( ! input )
+    {
+        fprintf(stderr, "silica_flight_recorder_reader: cannot open %s\n", argv[1]);
+        return 2;
+    }
+
+    const bool isValid = Silica::readFlightRecorder(input, stdout);
+    fclose(input);
+    if( ! isValid )
+    {
+        fprintf(stderr, "silica_flight_recorder_reader: %s is not a flight recorder file, or is truncated\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,273 @@
+#include "BinaryLogDecoder.h"
+#include <silica/BinaryLog.h>
+#include <silica/LogRecord.h>
+#include <string.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Silica
+{
+
+namespace
+{
+
+struct DecodedSite
+{
+    std::string file;
+    std::string formatString;
+    std::string argumentTypes;
+    uint32_t line = 0;
+    LogEntry::Type type = LogEntry::Type::Log;
+};
+
+struct Argument
+{
+    char type = 0;
+    uint64_t bits = 0;
+    std::string string;
+};
+
+template<typename T>
+bool readValue(FILE *input, T &value)
+{
+    return fread(&value, sizeof(value), 1, input) == 1;
+}
+
+bool readString(FILE *input, std::string &string)
+{
+    uint16_t length;
+    if( ! readValue(input, length) )
+    {
+        return false;
+    }
+    string.resize(length);
+    return (length == 0) || (fread(&string[0], 1, length, input) == length);
+}
+
+const char *baseName(const std::string &path)
+{
+    const size_t separator = path.find_last_of("/\\");
+    return path.c_str() + ( (separator == std::string::npos) ? 0 : separator + 1 );
+}
+
+bool decodeArguments(const DecodedSite &site, const uint8_t *payload, size_t size, std::vector<Argument> &arguments)
+{
+    arguments.clear();
+    size_t offset = 0;
+    for(const char type : site.argumentTypes)
+    {
+        Argument argument;
+        argument.type = type;
+        if(type == static_cast<char>(BinaryLog::ArgumentType::String))
+        {
+            uint16_t length;
+            if(offset + sizeof(length) > size)
+            {
+                return false;
+            }
+            memcpy(&length, payload + offset, sizeof(length));
+            offset += sizeof(length);
+            if(offset + length > size)
+            {
+                return false;
+            }
+            argument.string.assign(reinterpret_cast<const char*>(payload + offset), length);
+            offset += length;
+        }
+        else
+        {
+            if(offset + sizeof(argument.bits) > size)
+            {
+                return false;
+            }
+            memcpy(&argument.bits, payload + offset, sizeof(argument.bits));
+            offset += sizeof(argument.bits);
+        }
+        arguments.push_back(argument);
+    }
+    return offset == size;
+}
+
+/*
+ * Formats one conversion at a time with snprintf. The length modifiers of
+ * the format string are replaced, as all integers were recorded as 64 bits.
+ */
+std::string render(const std::string &formatString, const std::vector<Argument> &arguments)
+{
+    std::string result;
+    size_t next = 0;
+    char piece[512];
+    for(size_t i = 0; i < formatString.size(); i++)
+    {
+        if( (formatString[i] != '%') || (i + 1 == formatString.size()) )
+        {
+            result += formatString[i];
+            continue;
+        }
+        if(formatString[i + 1] == '%')
+        {
+            result += '%';
+            i++;
+            continue;
+        }
+
+        std::string specification = "%";
+        size_t j = i + 1;
+        while( (j < formatString.size()) && strchr("-+ #0123456789.", formatString[j]) )
+        {
+            specification += formatString[j++];
+        }
+        while( (j < formatString.size()) && strchr("hljztLq", formatString[j]) )
+        {
+            j++;
+        }
+        if(j == formatString.size())
+        {
+            result += formatString.substr(i);
+            break;
+        }
+        const char conversion = formatString[j];
+        i = j;
+
+        if(next == arguments.size())
+        {
+            result += "<missing>";
+            continue;
+        }
+        const Argument &argument = arguments[next++];
+        const bool isSigned = argument.type == static_cast<char>(BinaryLog::ArgumentType::Signed);
+        double floatingPoint;
+        memcpy(&floatingPoint, &argument.bits, sizeof(floatingPoint));
+
+        if(argument.type == static_cast<char>(BinaryLog::ArgumentType::String))
+        {
+            snprintf(piece, sizeof(piece), (specification + 's').c_str(), argument.string.c_str());
+        }
+        else if(strchr("eEfFgGaA", conversion))
+        {
+            const bool isFloatingPoint = argument.type == static_cast<char>(BinaryLog::ArgumentType::FloatingPoint);
+            const double value = isFloatingPoint ? floatingPoint
+                                                 : isSigned ? static_cast<double>(static_cast<int64_t>(argument.bits))
+                                                            : static_cast<double>(argument.bits);
+            snprintf(piece, sizeof(piece), (specification + conversion).c_str(), value);
+        }
+        else if(conversion == 'p')
+        {
+            snprintf(piece, sizeof(piece), (specification + 'p').c_str(), reinterpret_cast<void*>(static_cast<uintptr_t>(argument.bits)));
+        }
+        else if(conversion == 'c')
+        {
+            snprintf(piece, sizeof(piece), (specification + 'c').c_str(), static_cast<int>(argument.bits));
+        }
+        else if(strchr("di", conversion))
+        {
+            snprintf(piece, sizeof(piece), (specification + "lld").c_str(), static_cast<long long>(argument.bits));
+        }
+        else if(strchr("ouxX", conversion))
+        {
+            snprintf(piece, sizeof(piece), (specification + "ll" + conversion).c_str(), static_cast<unsigned long long>(argument.bits));
+        }
+        else
+        {
+            snprintf(piece, sizeof(piece), "<%%%c?>", conversion);
+        }
+        result += piece;
+    }
+    return result;
+}
+
+}
+
+bool decodeBinaryLog(FILE *input, FILE *output, size_t *entryCount)
+{
+    std::map<uint32_t, DecodedSite> sites;
+    std::vector<uint8_t> records;
+    std::vector<Argument> arguments;
+    size_t count = 0;
+    bool isValid = true;
+
+    char magic[sizeof(BinaryLog::segmentMagic)];
+    while(isValid && (fread(magic, sizeof(magic), 1, input) == 1))
+    {
+        if(memcmp(magic, BinaryLog::segmentMagic, sizeof(magic)) != 0)
+        {
+            isValid = false;
+            break;
+        }
+
+        for(;;)
+        {
+            uint8_t tag;
+            if( ! readValue(input, tag) )
+            {
+                isValid = false;
+                break;
+            }
+            if(tag == BinaryLog::endTag)
+            {
+                break;
+            }
+            if(tag == BinaryLog::siteTag)
+            {
+                uint32_t id;
+                uint8_t type;
+                DecodedSite site;
+                isValid = readValue(input, id) && readValue(input, site.line) && readValue(input, type)
+                          && readString(input, site.file) && readString(input, site.formatString) && readString(input, site.argumentTypes);
+                site.type = static_cast<LogEntry::Type>(type);
+                sites[id] = site;
+            }
+            else if(tag == BinaryLog::recordsTag)
+            {
+                uint32_t length;
+                isValid = readValue(input, length);
+                records.resize(length);
+                isValid = isValid && ( (length == 0) || (fread(records.data(), 1, length, input) == length) );
+
+                for(size_t offset = 0; isValid && (offset < records.size()); )
+                {
+                    uint32_t id;
+                    uint16_t size;
+                    if(offset + BinaryLog::recordHeaderSize > records.size())
+                    {
+                        isValid = false;
+                        break;
+                    }
+                    memcpy(&id, &records[offset], sizeof(id));
+                    memcpy(&size, &records[offset + sizeof(id)], sizeof(size));
+                    offset += BinaryLog::recordHeaderSize;
+                    const auto site = sites.find(id);
+                    if( (site == sites.end()) || (offset + size > records.size())
+                        || ! decodeArguments(site->second, &records[offset], size, arguments) )
+                    {
+                        isValid = false;
+                        break;
+                    }
+                    offset += size;
+
+                    const char indicator = LogRecord::indicatorOf(site->second.type);
+                    fprintf(output, "# %c : %4u : %s : %s\n", indicator, site->second.line, baseName(site->second.file),
+                            render(site->second.formatString, arguments).c_str());
+                    count++;
+                }
+            }
+            else
+            {
+                isValid = false;
+            }
+            if( ! isValid )
+            {
+                break;
+            }
+        }
+    }
+
+    if(entryCount)
+    {
+        *entryCount = count;
+    }
+    return isValid;
+}
+
+}
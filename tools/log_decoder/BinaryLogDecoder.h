@@ -0,0 +1,21 @@
+#ifndef SILICA_BINARY_LOG_DECODER_H
+#define SILICA_BINARY_LOG_DECODER_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+namespace Silica
+{
+
+/** \brief Reads the segments Silica::BinaryLog::drain() wrote to \p input, and writes one line of text per entry to \p output.
+
+The lines look like those of the default LogSink: type, line, file and message.
+
+\param entryCount If not null, receives the number of entries decoded.
+\returns True if all of \p input was decoded, false if it is not a binary log, or is truncated.
+*/
+bool decodeBinaryLog(FILE *input, FILE *output, size_t *entryCount = nullptr);
+
+}
+
+#endif // SILICA_BINARY_LOG_DECODER_H
@@ -0,0 +1,34 @@
+#include "BinaryLogDecoder.h"
+
+/*
+ * silica_log_decoder [file]
+ *
+ * Turns the output of Silica::BinaryLog::drain() into text. Reads standard
+ * input if no file is given.
+ */
+int main(int argc, char **argv)
+{
+    FILE *input = stdin;
+    if(argc > 1)
+    {
+        input = fopen(argv[1], "rb");
+        if( ! input )
+        {
+            fprintf(stderr, "silica_log_decoder: cannot open %s\n", argv[1]);
+            return 2;
+        }
+    }
+
+    size_t entryCount = 0;
+    const bool isValid = Silica::decodeBinaryLog(input, stdout, &entryCount);
+    if(input != stdin)
+    {
+        fclose(input);
+    }
+    if( ! isValid )
+    {
+        fprintf(stderr, "silica_log_decoder: input is corrupt or truncated after %zu entries\n", entryCount);
+        return 1;
+    }
+    return 0;
+}